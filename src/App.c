@@ -23,10 +23,14 @@ SOFTWARE.
 -------------------------------------------------------------------------------*/
 
 #include "App.h"
+#include "base/AssetLoader.h"
+#include "base/AssetWatcher.h"
 #include "base/DataZipFile.h"
+#include "base/FrameStats.h"
 #include "base/Window.h"
 #include "base/Graphics.h"
 #include "base/SceneManager.h"
+#include "base/opengl_renderer/OpenGLRenderer.h"
 #include "scene_game/SceneGame.h"
 
 #include <SDL2/SDL.h>
@@ -46,11 +50,12 @@ struct App
     Window *window;
     Graphics *graphics;
     SceneManager *sceneManager;
+    bool frameStats;
 };
 
-static void InitSDL();
+static void InitSDL(bool headless);
 
-App *App_New()
+App *App_New(const AppOptions *options)
 {
     srand(time(NULL));
 
@@ -59,13 +64,62 @@ App *App_New()
         return NULL;
 #endif
 
-    InitSDL();
+    InitSDL(options->headless);
+
+    if (!AssetLoader_Init())
+        return NULL;
+
+    AssetWatcher_Init();
 
     App * const self = malloc(sizeof (App));
 
-    self->window = Window_New(640, 480, "Tic Tac Toe");
+    self->window = Window_New(640, 480, "Tic Tac Toe", options->headless);
     self->graphics = Graphics_New(self->window);
+
+    OpenGLRenderer *renderer = Graphics_GetRenderer(self->graphics);
+    AssetLoader_SetCompressedFormats(OpenGLRenderer_IsImageFormatSupported(renderer, ImageFormat_ETC2),
+                                     OpenGLRenderer_IsImageFormatSupported(renderer, ImageFormat_S3TC));
     self->sceneManager = SceneManager_New(self->window, self->graphics);
+    self->frameStats = options->frameStats || options->replayFile || options->headless;
+
+    SceneManager_SetFixedDeltaTime(self->sceneManager, options->fixedDeltaTime);
+    SceneManager_SetFrameLimit(self->sceneManager, options->frames);
+    SceneManager_SetSnapshots(self->sceneManager, options->snapshotDirectory, options->snapshotInterval);
+
+    if (options->dynamicResolution > 0.0)
+        SceneManager_SetDynamicResolution(self->sceneManager, options->dynamicResolution);
+    else if (options->renderScale > 0.0f)
+        OpenGLRenderer_SetRenderScale(renderer, options->renderScale);
+
+    OpenGLRenderer_SetOverdrawView(renderer, options->overdraw);
+
+    if (options->headless)
+    {
+        IVec2 size = Window_GetSize(self->window);
+
+        // Without framebuffer objects the hidden window's own buffer is used
+        OpenGLRenderer_SetOffscreen(renderer, size.w, size.h);
+        SceneManager_SetHeadless(self->sceneManager, true);
+        Window_SetVSync(self->window, false);
+    }
+
+    if (options->replayFile)
+    {
+        if (!SceneManager_ReplayInput(self->sceneManager, options->replayFile))
+        {
+            App_Delete(self);
+            return NULL;
+        }
+
+        // Replays run as fast as they can
+        Window_SetVSync(self->window, false);
+    }
+
+    if (options->recordFile && !SceneManager_RecordInput(self->sceneManager, options->recordFile))
+    {
+        App_Delete(self);
+        return NULL;
+    }
 
     Window_SetWindowIcon(self->window, "images/player_1.png");
 
@@ -80,7 +134,12 @@ void App_Delete(App * const self)
     if (!self)
         return;
 
+    if (self->frameStats)
+        FrameStats_Print(SceneManager_FrameStats(self->sceneManager), stdout);
+
     SceneManager_Delete(self->sceneManager);
+    AssetWatcher_Quit();
+    AssetLoader_Quit();
     Graphics_Delete(self->graphics);
     Window_Delete(self->window);
 
@@ -101,8 +160,16 @@ void App_Run(App * const self)
     SceneManager_Run(self->sceneManager);
 }
 
-void InitSDL()
+void InitSDL(bool headless)
 {
+#ifdef __linux__
+    // SDL's offscreen driver creates the context on an EGL pbuffer, no display needed
+    if (headless && !SDL_getenv("SDL_VIDEODRIVER") && !SDL_getenv("DISPLAY") && !SDL_getenv("WAYLAND_DISPLAY"))
+        SDL_setenv("SDL_VIDEODRIVER", "offscreen", 1);
+#else
+    (void)headless;
+#endif
+
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) < 0)
     {
         printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
@@ -24,8 +24,34 @@ SOFTWARE.
 
 #pragma once
 
+#include <stdbool.h>
+#include <stdint.h>
+
 typedef struct App App;
 
-App *App_New();
+typedef struct AppOptions
+{
+    const char *recordFile;
+    const char *replayFile;
+    // Seconds per update, 0 measures the real frame time
+    double fixedDeltaTime;
+    // Prints the frame time histogram on exit
+    bool frameStats;
+    // Renders offscreen in a hidden window, without a display on Linux
+    bool headless;
+    // Quits after this many frames, 0 runs until quit or the end of the replay
+    uint64_t frames;
+    // Directory for PNG snapshots of every snapshotInterval frames and of the last one
+    const char *snapshotDirectory;
+    uint64_t snapshotInterval;
+    // GPU time budget of a frame in seconds, the render scale drops while frames go over it. 0 is off
+    double dynamicResolution;
+    // Fixed render scale, from 0.25 to 1, when dynamic resolution is off
+    float renderScale;
+    // Shows how many times each pixel is drawn instead of the scene
+    bool overdraw;
+} AppOptions;
+
+App *App_New(const AppOptions *options);
 void App_Delete(App * const self);
 void App_Run(App * const self);
@@ -0,0 +1,60 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum Easing
+{
+    Easing_Linear = 0,
+    Easing_QuadOut = 1,
+    Easing_SmoothStep = 2,
+    Easing_CubicOut = 3
+} Easing;
+
+// Motion evaluated by the vertex shader from the renderer clock (OpenGLRenderer_SetTime), so an animated
+// quad costs nothing on the CPU after it's set. Rotation and pulse are around the center of the quad.
+// All zero is a quad that doesn't move
+typedef struct Animation
+{
+    // Seconds on the renderer clock
+    float startTime;
+    // Degrees per second, clockwise
+    float angularVelocity;
+    // Scale of 1 + amplitude * sin(2 pi frequency t)
+    float pulseAmplitude;
+    float pulseFrequency;
+    // Offset from the drawn position at the start, eased to 0 over slideDuration seconds
+    float slideX;
+    float slideY;
+    float slideDuration;
+    Easing slideEasing;
+} Animation;
+
+#ifdef __cplusplus
+}
+#endif
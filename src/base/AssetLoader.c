@@ -0,0 +1,490 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#include "AssetLoader.h"
+#include "CookedImageFormat.h"
+#include "DataZipFile.h"
+#include "opengl_renderer/GLTexture.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+
+#define MAX_WORKERS 4
+
+typedef struct CookedVariant
+{
+    const char *suffix;
+    CookedImageFormat format;
+    ImageFormat imageFormat;
+} CookedVariant;
+
+// Most compact first, RGBA8 is always readable
+static const CookedVariant Variants[] = {
+    {".etc2.tex", CookedFormat_ETC2_RGBA8, ImageFormat_ETC2},
+    {".s3tc.tex", CookedFormat_S3TC_DXT5, ImageFormat_S3TC},
+    {".tex", CookedFormat_RGBA8, ImageFormat_Pixels},
+};
+
+typedef struct Job
+{
+    char *filename;
+    AssetLoader_OnLoaded callback;
+    void *userdata;
+    bool sourceOnly;
+    uint32_t formats;
+    bool loaded;
+    Image image;
+    SDL_Surface *surface;
+    void *cooked;
+    bool canceled;
+    struct Job *next;
+} Job;
+
+typedef struct JobQueue
+{
+    Job *first;
+    Job *last;
+} JobQueue;
+
+static struct
+{
+    bool running;
+    uint32_t formats;
+    JobQueue pending;
+    JobQueue done;
+    Job *working[MAX_WORKERS];
+
+#ifndef __EMSCRIPTEN__
+    SDL_mutex *mutex;
+    SDL_cond *condition;
+    SDL_Thread *workers[MAX_WORKERS];
+    int workersCount;
+#endif
+} loader;
+
+static void Enqueue(const char *filename, bool sourceOnly, AssetLoader_OnLoaded callback, void *userdata);
+static void Push(JobQueue *queue, Job *job);
+static Job *Pop(JobQueue *queue);
+static void FreeJob(Job *job);
+static void Cancel(JobQueue *queue, void *userdata);
+static void Decode(Job *job);
+static bool LoadCooked(Job *job);
+static bool ParseCooked(Job *job, const CookedVariant *variant, const unsigned char *data, size_t size);
+static bool LoadPNG(Job *job);
+
+#ifndef __EMSCRIPTEN__
+static int WorkerThread(void *data)
+{
+    const int index = (int) (intptr_t) data;
+
+    SDL_LockMutex(loader.mutex);
+
+    while (loader.running)
+    {
+        Job *job = Pop(&loader.pending);
+
+        if (!job)
+        {
+            SDL_CondWait(loader.condition, loader.mutex);
+            continue;
+        }
+
+        loader.working[index] = job;
+        SDL_UnlockMutex(loader.mutex);
+
+        Decode(job);
+
+        SDL_LockMutex(loader.mutex);
+        loader.working[index] = NULL;
+
+        if (job->canceled)
+            FreeJob(job);
+        else
+            Push(&loader.done, job);
+    }
+
+    SDL_UnlockMutex(loader.mutex);
+
+    return 0;
+}
+#endif
+
+bool AssetLoader_Init()
+{
+    loader.running = true;
+    loader.formats = 1u << CookedFormat_RGBA8;
+    loader.pending = (JobQueue) {NULL, NULL};
+    loader.done = (JobQueue) {NULL, NULL};
+
+    for (int i = 0; i < MAX_WORKERS; ++i)
+        loader.working[i] = NULL;
+
+#ifndef __EMSCRIPTEN__
+    loader.mutex = SDL_CreateMutex();
+    loader.condition = SDL_CreateCond();
+
+    if (!loader.mutex || !loader.condition)
+    {
+        printf("Asset loader could not be created! SDL Error: %s\n", SDL_GetError());
+        return false;
+    }
+
+    // Leave one core to the main thread
+    loader.workersCount = SDL_GetCPUCount() - 1;
+
+    if (loader.workersCount < 1)
+        loader.workersCount = 1;
+    else if (loader.workersCount > MAX_WORKERS)
+        loader.workersCount = MAX_WORKERS;
+
+    for (int i = 0; i < loader.workersCount; ++i)
+    {
+        loader.workers[i] = SDL_CreateThread(WorkerThread, "AssetLoader", (void *) (intptr_t) i);
+
+        if (!loader.workers[i])
+        {
+            printf("Asset loader thread could not be created! SDL Error: %s\n", SDL_GetError());
+            loader.workersCount = i;
+            break;
+        }
+    }
+#endif
+
+    return true;
+}
+
+void AssetLoader_Quit()
+{
+#ifndef __EMSCRIPTEN__
+    SDL_LockMutex(loader.mutex);
+    loader.running = false;
+    SDL_CondBroadcast(loader.condition);
+    SDL_UnlockMutex(loader.mutex);
+
+    for (int i = 0; i < loader.workersCount; ++i)
+        SDL_WaitThread(loader.workers[i], NULL);
+
+    SDL_DestroyCond(loader.condition);
+    SDL_DestroyMutex(loader.mutex);
+#endif
+
+    for (Job *job; (job = Pop(&loader.pending));)
+        FreeJob(job);
+
+    for (Job *job; (job = Pop(&loader.done));)
+        FreeJob(job);
+}
+
+void AssetLoader_LoadImage(const char *filename, AssetLoader_OnLoaded callback, void *userdata)
+{
+    Enqueue(filename, false, callback, userdata);
+}
+
+void AssetLoader_LoadSourceImage(const char *filename, AssetLoader_OnLoaded callback, void *userdata)
+{
+    Enqueue(filename, true, callback, userdata);
+}
+
+void AssetLoader_SetCompressedFormats(bool etc2, bool s3tc)
+{
+    loader.formats = 1u << CookedFormat_RGBA8;
+
+    if (etc2)
+        loader.formats |= 1u << CookedFormat_ETC2_RGBA8;
+
+    if (s3tc)
+        loader.formats |= 1u << CookedFormat_S3TC_DXT5;
+}
+
+void AssetLoader_Cancel(void *userdata)
+{
+#ifndef __EMSCRIPTEN__
+    SDL_LockMutex(loader.mutex);
+
+    // A job being decoded is freed by its worker when it finishes
+    for (int i = 0; i < loader.workersCount; ++i)
+        if (loader.working[i] && loader.working[i]->userdata == userdata)
+            loader.working[i]->canceled = true;
+#endif
+
+    Cancel(&loader.pending, userdata);
+    Cancel(&loader.done, userdata);
+
+#ifndef __EMSCRIPTEN__
+    SDL_UnlockMutex(loader.mutex);
+#endif
+}
+
+void AssetLoader_Update(double budgetMs)
+{
+    const Uint64 start = SDL_GetPerformanceCounter();
+    const Uint64 budget = budgetMs * SDL_GetPerformanceFrequency() / 1000.0;
+
+    do
+    {
+#ifdef __EMSCRIPTEN__
+        // No worker threads, the decode takes its share of the frame here
+        Job *job = Pop(&loader.pending);
+
+        if (job)
+            Decode(job);
+#else
+        SDL_LockMutex(loader.mutex);
+        Job *job = Pop(&loader.done);
+        SDL_UnlockMutex(loader.mutex);
+#endif
+
+        if (!job)
+            return;
+
+        job->callback(job->loaded ? &job->image : NULL, job->userdata);
+
+        FreeJob(job);
+    }
+    while (SDL_GetPerformanceCounter() - start < budget);
+}
+
+void Enqueue(const char *filename, bool sourceOnly, AssetLoader_OnLoaded callback, void *userdata)
+{
+    Job *job = malloc(sizeof (Job));
+
+    const size_t size = strlen(filename) + 1;
+    job->filename = malloc(size);
+    memcpy(job->filename, filename, size);
+
+    job->callback = callback;
+    job->userdata = userdata;
+    job->sourceOnly = sourceOnly;
+    job->formats = loader.formats;
+    job->loaded = false;
+    job->surface = NULL;
+    job->cooked = NULL;
+    job->canceled = false;
+    job->next = NULL;
+
+#ifdef __EMSCRIPTEN__
+    Push(&loader.pending, job);
+#else
+    SDL_LockMutex(loader.mutex);
+    Push(&loader.pending, job);
+    SDL_CondSignal(loader.condition);
+    SDL_UnlockMutex(loader.mutex);
+#endif
+}
+
+void Push(JobQueue *queue, Job *job)
+{
+    job->next = NULL;
+
+    if (queue->last)
+        queue->last->next = job;
+    else
+        queue->first = job;
+
+    queue->last = job;
+}
+
+Job *Pop(JobQueue *queue)
+{
+    Job *job = queue->first;
+
+    if (job)
+    {
+        queue->first = job->next;
+
+        if (!queue->first)
+            queue->last = NULL;
+    }
+
+    return job;
+}
+
+void FreeJob(Job *job)
+{
+    SDL_FreeSurface(job->surface);
+    SDL_free(job->cooked);
+    free(job->filename);
+    free(job);
+}
+
+void Cancel(JobQueue *queue, void *userdata)
+{
+    JobQueue kept = {NULL, NULL};
+
+    for (Job *job; (job = Pop(queue));)
+    {
+        if (job->userdata == userdata)
+            FreeJob(job);
+        else
+            Push(&kept, job);
+    }
+
+    *queue = kept;
+}
+
+void Decode(Job *job)
+{
+    job->loaded = (!job->sourceOnly && LoadCooked(job)) || LoadPNG(job);
+}
+
+bool LoadCooked(Job *job)
+{
+    const size_t length = strlen(job->filename);
+
+    if (length < 4 || strcmp(job->filename + length - 4, ".png") != 0)
+        return false;
+
+    for (size_t i = 0; i < sizeof (Variants) / sizeof (Variants[0]); ++i)
+    {
+        const CookedVariant *variant = &Variants[i];
+
+        if (!(job->formats & (1u << variant->format)))
+            continue;
+
+        char filename[1024];
+        snprintf(filename, sizeof (filename), "%.*s%s", (int) (length - 4), job->filename, variant->suffix);
+
+#ifdef USE_DATA_ZIP
+        SDL_RWops *file = DataZipFile_Exists(filename) ? DataZipFile_Load_RW(filename) : NULL;
+#else
+        SDL_RWops *file = SDL_RWFromFile(filename, "rb");
+#endif
+
+        if (!file)
+            continue;
+
+        size_t size;
+        job->cooked = SDL_LoadFile_RW(file, &size, 1);
+
+        if (job->cooked && ParseCooked(job, variant, job->cooked, size))
+            return true;
+
+        printf("Invalid cooked image %s\n", filename);
+
+        SDL_free(job->cooked);
+        job->cooked = NULL;
+    }
+
+    return false;
+}
+
+bool ParseCooked(Job *job, const CookedVariant *variant, const unsigned char *data, size_t size)
+{
+    if (size < sizeof (CookedImageHeader))
+        return false;
+
+    const CookedImageHeader *header = (const CookedImageHeader *) data;
+
+    if (header->magic != COOKED_IMAGE_MAGIC
+            || header->version != COOKED_IMAGE_VERSION
+            || header->format != variant->format
+            || header->width == 0 || header->width > 16384
+            || header->height == 0 || header->height > 16384
+            || header->levels == 0 || header->levels > IMAGE_MAX_MIPMAPS + 1)
+        return false;
+
+    size_t offset = sizeof (CookedImageHeader);
+    Image *image = &job->image;
+
+    *image = (Image) {
+        .format = variant->imageFormat,
+        .width = header->width,
+        .height = header->height,
+        .bytesPerPixel = 4,
+        .pitch = header->width * 4,
+        .rmask = 0x000000ff,
+        .mipmapsCount = header->levels - 1,
+    };
+
+    for (uint32_t i = 0; i < header->levels; ++i)
+    {
+        const int width = header->width >> i ? header->width >> i : 1;
+        const int height = header->height >> i ? header->height >> i : 1;
+
+        uint32_t levelSize;
+
+        if (size - offset < sizeof (levelSize))
+            return false;
+
+        memcpy(&levelSize, data + offset, sizeof (levelSize));
+        offset += sizeof (levelSize);
+
+        if (levelSize != CookedImage_LevelSize(header->format, width, height) || size - offset < levelSize)
+            return false;
+
+        if (i == 0)
+        {
+            image->pixels = (unsigned char *) data + offset;
+            image->size = levelSize;
+        }
+        else
+        {
+            image->mipmaps[i - 1] = (ImageLevel) {width, height, levelSize, data + offset};
+        }
+
+        offset += (levelSize + 3) & ~3u;
+
+        if (offset > size)
+            return false;
+    }
+
+    // Partial chains are not complete textures, the GPU builds the levels then
+    const int largest = header->width > header->height ? header->width : header->height;
+
+    if (largest >> (header->levels - 1) != 1)
+        image->mipmapsCount = 0;
+
+    return true;
+}
+
+bool LoadPNG(Job *job)
+{
+#ifdef USE_DATA_ZIP
+    SDL_Surface *surface = IMG_Load_RW(DataZipFile_Load_RW(job->filename), 1);
+#else
+    SDL_Surface *surface = IMG_Load(job->filename);
+#endif
+
+    if (!surface)
+    {
+        printf("Unable to load image %s! SDL_image Error: %s\n", job->filename, IMG_GetError());
+        return false;
+    }
+
+    job->surface = surface;
+    job->image = (Image) {
+        .width = surface->w,
+        .height = surface->h,
+        .bytesPerPixel = surface->format->BytesPerPixel,
+        .pitch = surface->pitch,
+        .rmask = surface->format->Rmask,
+        .pixels = surface->pixels,
+    };
+
+    return true;
+}
@@ -0,0 +1,57 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct Image Image;
+
+// Called on the main thread, the image is only valid during the call. NULL means the file could not be loaded
+typedef void (*AssetLoader_OnLoaded)(const Image *image, void *userdata);
+
+bool AssetLoader_Init();
+void AssetLoader_Quit();
+
+// Reads and decodes the image on a worker thread. A cooked .tex next to a .png is used instead of it
+void AssetLoader_LoadImage(const char *filename, AssetLoader_OnLoaded callback, void *userdata);
+// Same, but always decodes the file itself, for when it is newer than its cooked copy
+void AssetLoader_LoadSourceImage(const char *filename, AssetLoader_OnLoaded callback, void *userdata);
+
+// Compressed cooked images the GPU samples, set once the renderer is up. Before, only RGBA8 ones are read
+void AssetLoader_SetCompressedFormats(bool etc2, bool s3tc);
+
+// Drops every request of this userdata, the callback is never called for them
+void AssetLoader_Cancel(void *userdata);
+
+// Delivers finished images until the frame budget is spent, at least one per call
+void AssetLoader_Update(double budgetMs);
+
+#ifdef __cplusplus
+}
+#endif
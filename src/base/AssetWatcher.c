@@ -0,0 +1,298 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#include "AssetWatcher.h"
+
+#ifdef ASSET_HOT_RELOAD
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#define EVENTS_BUFFER_SIZE 4096
+
+typedef struct Watch
+{
+    char *filename;
+    char *stem;
+    AssetWatcher_OnChanged callback;
+    void *userdata;
+    char changed[256];
+    struct Watch *next;
+} Watch;
+
+typedef struct Directory
+{
+    char *path;
+    int descriptor;
+    struct Directory *next;
+} Directory;
+
+static struct
+{
+    int fd;
+    Watch *watches;
+    Directory *directories;
+} watcher = {-1, NULL, NULL};
+
+static char *CopyString(const char *string, size_t length);
+static bool WatchDirectory(const char *filename);
+static Directory *FindDirectory(int descriptor);
+static bool IsCookedCopy(const Watch *watch, const char *path);
+static void MarkChanged(const char *path);
+
+void AssetWatcher_Init()
+{
+    watcher.fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (watcher.fd < 0)
+        puts("Asset watcher could not be created, hot reload is disabled");
+}
+
+void AssetWatcher_Quit()
+{
+    while (watcher.watches)
+        AssetWatcher_Unwatch(watcher.watches->userdata);
+
+    while (watcher.directories)
+    {
+        Directory *directory = watcher.directories;
+        watcher.directories = directory->next;
+
+        free(directory->path);
+        free(directory);
+    }
+
+    if (watcher.fd >= 0)
+        close(watcher.fd);
+
+    watcher.fd = -1;
+}
+
+void AssetWatcher_Watch(const char *filename, AssetWatcher_OnChanged callback, void *userdata)
+{
+    if (watcher.fd < 0)
+        return;
+
+    for (Watch *watch = watcher.watches; watch; watch = watch->next)
+        if (watch->userdata == userdata && watch->callback == callback && strcmp(watch->filename, filename) == 0)
+            return;
+
+    if (!WatchDirectory(filename))
+        return;
+
+    Watch *watch = malloc(sizeof (Watch));
+
+    watch->filename = CopyString(filename, strlen(filename));
+    watch->stem = NULL;
+    watch->callback = callback;
+    watch->userdata = userdata;
+    watch->changed[0] = '\0';
+
+    const char *extension = strrchr(filename, '.');
+
+    if (extension && !strchr(extension, '/') && strcmp(extension, ".tex") != 0)
+        watch->stem = CopyString(filename, extension - filename);
+
+    watch->next = watcher.watches;
+    watcher.watches = watch;
+}
+
+void AssetWatcher_Unwatch(void *userdata)
+{
+    for (Watch **link = &watcher.watches; *link;)
+    {
+        Watch *watch = *link;
+
+        if (watch->userdata != userdata)
+        {
+            link = &watch->next;
+            continue;
+        }
+
+        *link = watch->next;
+
+        free(watch->filename);
+        free(watch->stem);
+        free(watch);
+    }
+}
+
+void AssetWatcher_Update()
+{
+    if (watcher.fd < 0)
+        return;
+
+    _Alignas(struct inotify_event) char buffer[EVENTS_BUFFER_SIZE];
+    ssize_t length;
+
+    while ((length = read(watcher.fd, buffer, sizeof (buffer))) > 0)
+    {
+        for (char *next = buffer; next < buffer + length;)
+        {
+            const struct inotify_event *event = (const struct inotify_event *) next;
+            next += sizeof (struct inotify_event) + event->len;
+
+            const Directory *directory = FindDirectory(event->wd);
+
+            if (!directory || event->len == 0)
+                continue;
+
+            char path[1024];
+
+            if (strcmp(directory->path, ".") == 0)
+                snprintf(path, sizeof (path), "%s", event->name);
+            else
+                snprintf(path, sizeof (path), "%s/%s", directory->path, event->name);
+
+            MarkChanged(path);
+        }
+    }
+
+    // Editors save in several steps, so each file is reported once per frame. The callbacks may unwatch
+    for (Watch *watch = watcher.watches; watch;)
+    {
+        if (!watch->changed[0])
+        {
+            watch = watch->next;
+            continue;
+        }
+
+        char path[sizeof (watch->changed)];
+        memcpy(path, watch->changed, sizeof (path));
+        watch->changed[0] = '\0';
+
+        printf("Asset %s changed, reloading\n", path);
+        watch->callback(path, watch->userdata);
+
+        watch = watcher.watches;
+    }
+}
+
+char *CopyString(const char *string, size_t length)
+{
+    char *copy = malloc(length + 1);
+
+    memcpy(copy, string, length);
+    copy[length] = '\0';
+
+    return copy;
+}
+
+bool WatchDirectory(const char *filename)
+{
+    const char *slash = strrchr(filename, '/');
+    char *path = slash ? CopyString(filename, slash - filename) : CopyString(".", 1);
+
+    for (Directory *directory = watcher.directories; directory; directory = directory->next)
+    {
+        if (strcmp(directory->path, path) == 0)
+        {
+            free(path);
+            return true;
+        }
+    }
+
+    // Directories instead of files, editors often save by renaming a new file over the old one
+    const int descriptor = inotify_add_watch(watcher.fd, path, IN_CLOSE_WRITE | IN_MOVED_TO);
+
+    if (descriptor < 0)
+    {
+        printf("Unable to watch directory %s\n", path);
+        free(path);
+        return false;
+    }
+
+    Directory *directory = malloc(sizeof (Directory));
+
+    directory->path = path;
+    directory->descriptor = descriptor;
+    directory->next = watcher.directories;
+    watcher.directories = directory;
+
+    return true;
+}
+
+Directory *FindDirectory(int descriptor)
+{
+    for (Directory *directory = watcher.directories; directory; directory = directory->next)
+        if (directory->descriptor == descriptor)
+            return directory;
+
+    return NULL;
+}
+
+// <stem>.tex, <stem>.etc2.tex, <stem>.s3tc.tex
+bool IsCookedCopy(const Watch *watch, const char *path)
+{
+    if (!watch->stem)
+        return false;
+
+    const size_t stemLength = strlen(watch->stem);
+    const size_t length = strlen(path);
+
+    return length >= stemLength + 4
+            && strncmp(path, watch->stem, stemLength) == 0
+            && path[stemLength] == '.'
+            && !strchr(path + stemLength, '/')
+            && strcmp(path + length - 4, ".tex") == 0;
+}
+
+void MarkChanged(const char *path)
+{
+    for (Watch *watch = watcher.watches; watch; watch = watch->next)
+        if (strcmp(watch->filename, path) == 0 || IsCookedCopy(watch, path))
+            snprintf(watch->changed, sizeof (watch->changed), "%s", path);
+}
+
+#else
+
+void AssetWatcher_Init()
+{
+}
+
+void AssetWatcher_Quit()
+{
+}
+
+void AssetWatcher_Watch(const char *filename, AssetWatcher_OnChanged callback, void *userdata)
+{
+    (void) filename;
+    (void) callback;
+    (void) userdata;
+}
+
+void AssetWatcher_Unwatch(void *userdata)
+{
+    (void) userdata;
+}
+
+void AssetWatcher_Update()
+{
+}
+
+#endif
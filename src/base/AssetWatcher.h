@@ -0,0 +1,52 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Watches asset files for changes in development builds (ASSET_HOT_RELOAD), otherwise every call is a no-op
+
+// Called on the main thread with the path that changed
+typedef void (*AssetWatcher_OnChanged)(const char *filename, void *userdata);
+
+void AssetWatcher_Init();
+void AssetWatcher_Quit();
+
+// Changes to the cooked copies of the file (same name ending in .tex) are reported too
+void AssetWatcher_Watch(const char *filename, AssetWatcher_OnChanged callback, void *userdata);
+
+// Removes every watch of this userdata
+void AssetWatcher_Unwatch(void *userdata);
+
+// Reports the changes since the last call, never blocks
+void AssetWatcher_Update();
+
+#ifdef __cplusplus
+}
+#endif
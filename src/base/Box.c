@@ -23,6 +23,7 @@ SOFTWARE.
 -------------------------------------------------------------------------------*/
 
 #include "Box.h"
+#include "IntrusiveList.h"
 #include "rect.h"
 
 #include <malloc.h>
@@ -35,19 +36,38 @@ typedef struct Box_UpdatedEvent
 
 struct Box
 {
+    // Position relative to the parent
     Rect rect;
+
+    // Cached window rect. A dirty box has only dirty descendants, so marking stops at the first one already dirty
+    Rect worldRect;
+    bool dirty;
+
+    Box *parent;
+    IntrusiveList children;
+    IntrusiveListLink sibling;
+
     Box_UpdatedEvent updatedEvent;
 };
 
 void Box_CallUpdatedEvent(Box * const self);
+void Box_Moved(Box * const self);
+void Box_Resized(Box * const self);
+void Box_MarkDirty(Box * const self);
+void Box_Detach(Box * const self);
 
 Box *Box_New(float x, float y, float width, float height)
 {
     Box * const self = malloc(sizeof (Box));
 
     self->rect = (Rect) {x, y, width, height};
+    self->worldRect = self->rect;
+    self->dirty = false;
+    self->parent = NULL;
     self->updatedEvent = (Box_UpdatedEvent) {NULL, NULL};
 
+    IntrusiveList_Init(&self->children);
+
     return self;
 }
 
@@ -56,9 +76,35 @@ void Box_Delete(Box * const self)
     if (!self)
         return;
 
+    Box_Detach(self);
+
+    // Children stay alive as roots
+    while (!IntrusiveList_IsEmpty(&self->children))
+        Box_SetParent(INTRUSIVE_LIST_ENTRY(IntrusiveList_GetFirst(&self->children), Box, sibling), NULL);
+
     free(self);
 }
 
+void Box_SetParent(Box * const self, Box *parent)
+{
+    if (self->parent == parent)
+        return;
+
+    Box_Detach(self);
+
+    self->parent = parent;
+
+    if (parent)
+        IntrusiveList_PushBack(&parent->children, &self->sibling);
+
+    Box_Moved(self);
+}
+
+Box *Box_Parent(Box * const self)
+{
+    return self->parent;
+}
+
 void Box_SetOnUpdateEvent(Box * const self, Box_UpdateEventHandler callback, void *userdata)
 {
     self->updatedEvent.function = callback;
@@ -76,12 +122,46 @@ void Box_CallUpdatedEvent(Box * const self)
         self->updatedEvent.function(self, self->updatedEvent.userdata);
 }
 
+void Box_Moved(Box * const self)
+{
+    Box_MarkDirty(self);
+    Box_CallUpdatedEvent(self);
+}
+
+void Box_Resized(Box * const self)
+{
+    // The size is not inherited, the children keep their place
+    self->worldRect.w = self->rect.w;
+    self->worldRect.h = self->rect.h;
+
+    Box_CallUpdatedEvent(self);
+}
+
+void Box_MarkDirty(Box * const self)
+{
+    if (self->dirty)
+        return;
+
+    self->dirty = true;
+
+    for (IntrusiveListLink *it = IntrusiveList_GetFirst(&self->children); it; it = IntrusiveList_GetNext(&self->children, it))
+        Box_MarkDirty(INTRUSIVE_LIST_ENTRY(it, Box, sibling));
+}
+
+void Box_Detach(Box * const self)
+{
+    if (self->parent)
+        IntrusiveList_Remove(&self->parent->children, &self->sibling);
+
+    self->parent = NULL;
+}
+
 void Box_SetSize(Box * const self, float w, float h)
 {
     self->rect.w = w;
     self->rect.h = h;
 
-    Box_CallUpdatedEvent(self);
+    Box_Resized(self);
 }
 
 void Box_SetPosition(Box * const self, float x, float y)
@@ -89,35 +169,35 @@ void Box_SetPosition(Box * const self, float x, float y)
     self->rect.x = x;
     self->rect.y = y;
 
-    Box_CallUpdatedEvent(self);
+    Box_Moved(self);
 }
 
 void Box_SetX(Box * const self, float x)
 {
     self->rect.x = x;
 
-    Box_CallUpdatedEvent(self);
+    Box_Moved(self);
 }
 
 void Box_SetY(Box * const self, float y)
 {
     self->rect.y = y;
 
-    Box_CallUpdatedEvent(self);
+    Box_Moved(self);
 }
 
 void Box_SetWidth(Box * const self, float w)
 {
     self->rect.w = w;
 
-    Box_CallUpdatedEvent(self);
+    Box_Resized(self);
 }
 
 void Box_SetHeight(Box * const self, float h)
 {
     self->rect.h = h;
 
-    Box_CallUpdatedEvent(self);
+    Box_Resized(self);
 }
 
 void Box_Move(Box * const self, float velX, float velY)
@@ -125,7 +205,7 @@ void Box_Move(Box * const self, float velX, float velY)
     self->rect.x += velX;
     self->rect.y += velY;
 
-    Box_CallUpdatedEvent(self);
+    Box_Moved(self);
 }
 
 float Box_X(Box * const self)
@@ -150,5 +230,20 @@ float Box_Height(Box * const self)
 
 const Rect *Box_Rect(Box * const self)
 {
-    return &self->rect;
+    if (self->dirty)
+    {
+        self->worldRect = self->rect;
+
+        if (self->parent)
+        {
+            const Rect *parent = Box_Rect(self->parent);
+
+            self->worldRect.x += parent->x;
+            self->worldRect.y += parent->y;
+        }
+
+        self->dirty = false;
+    }
+
+    return &self->worldRect;
 }
@@ -24,6 +24,8 @@ SOFTWARE.
 
 #pragma once
 
+#include <stdbool.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -32,9 +34,17 @@ typedef struct Rect Rect;
 typedef struct Box Box;
 typedef void (*Box_UpdateEventHandler)(Box * const box, void *userdata);
 
+// Scene graph node: the position of a box is relative to its parent and Box_Rect is in window
+// coordinates, recomputed only after the box or one of its ancestors moved. Moving a box never
+// calls the update events of its children
+
 Box *Box_New(float x, float y, float width, float height);
 void Box_Delete(Box * const self);
 
+// NULL makes the box a root. The local position is kept, so the box moves with its new parent
+void Box_SetParent(Box * const self, Box *parent);
+Box *Box_Parent(Box * const self);
+
 void Box_SetOnUpdateEvent(Box * const self, Box_UpdateEventHandler callback, void *userdata);
 void *Box_GetEventUserData(Box * const self);
 
@@ -25,12 +25,11 @@ SOFTWARE.
 #include "Button.h"
 #include "Rectangle.h"
 #include "Box.h"
+#include "InputRouter.h"
 #include "rect.h"
 
 #include <malloc.h>
 
-#include <SDL2/SDL_events.h>
-
 typedef enum State
 {
     Normal,
@@ -51,7 +50,11 @@ struct Button
     Texture *textTexture;
     Texture *iconTexture;
 
+    // Parent of the background, the text and the icon box
     Box *box;
+    // The icon texture may be shared, so the button keeps its own box for it
+    Box *iconBox;
+    bool layoutDirty;
 
     Color color;
     Color colorHover;
@@ -61,13 +64,14 @@ struct Button
 
     Rectangle *background;
 
+    InputRouter *inputRouter;
     State state;
 
     Button_PressedEvent pressedEvent;
 };
 
-bool Button_PointerIsHovering(Button * const self, const SDL_Event *event);
-void Button_OnUpdateBox(Button * const self);
+void Button_OnPointer(void *userdata, InputRouter_Pointer pointer, const SDL_Event *event);
+void Button_CenterContent(Button * const self, Box *box, Texture *texture);
 void Button_CallPressedEvent(Button * const self);
 void Button_BoxOnUpdateEvent(Box * const box, void *userdata);
 
@@ -84,13 +88,19 @@ Button *Button_New(OpenGLRenderer *renderer)
     self->colorPressed = (Color) {60, 60, 60, 255};
     self->textColor = (Color) {255, 255, 255, 255};
 
+    self->inputRouter = NULL;
     self->state = Normal;
     self->pressedEvent = (Button_PressedEvent) {NULL, NULL};
 
     self->box = Box_New(0.f, 0.f, 60.f, 40.f);
+    self->iconBox = Box_New(0.f, 0.f, 0.f, 0.f);
+    self->layoutDirty = true;
 
     self->background = Rectangle_New(self->renderer, Box_Width(self->box), Box_Height(self->box));
 
+    Box_SetParent(Rectangle_Box(self->background), self->box);
+    Box_SetParent(self->iconBox, self->box);
+
     Box_SetOnUpdateEvent(self->box, Button_BoxOnUpdateEvent, self);
 
     return self;
@@ -101,7 +111,13 @@ void Button_Delete(Button * const self)
     if (!self)
         return;
 
+    if (self->inputRouter)
+        InputRouter_RemoveTarget(self->inputRouter, self);
+
     Texture_Delete(self->textTexture);
+    Rectangle_Delete(self->background);
+    Box_Delete(self->iconBox);
+    Box_Delete(self->box);
     free(self);
 }
 
@@ -153,6 +169,11 @@ void Button_SetBackgroundPressedColorRGBA(Button * const self, uint8_t r, uint8_
     self->colorPressed.a = a;
 }
 
+void Button_SetBackgroundRadius(Button * const self, float radius)
+{
+    Rectangle_SetRadius(self->background, radius);
+}
+
 void Button_SetTextColorRGB(Button * const self, uint8_t r, uint8_t g, uint8_t b)
 {
     self->textColor.r = r;
@@ -172,25 +193,21 @@ void Button_SetTextColorRGBA(Button * const self, uint8_t r, uint8_t g, uint8_t
 bool Button_SetText(Button * const self, const char *text, int ptsize)
 {
     if (!self->textTexture)
+    {
         self->textTexture = Texture_New(self->renderer);
+        Box_SetParent(Texture_Box(self->textTexture), self->box);
+    }
 
     Texture_SetTextColor(self->textTexture, &self->textColor);
     Texture_SetTextSize(self->textTexture, ptsize);
     Texture_SetText(self->textTexture, text);
 
-    if (Texture_MakeText(self->textTexture))
-    {
-        Button_OnUpdateBox(self);
-        return true;
-    }
-
-    return false;
+    return Texture_MakeText(self->textTexture);
 }
 
 void Button_SetIcon(Button * const self, Texture *texture)
 {
     self->iconTexture = texture;
-    Button_OnUpdateBox(self);
 }
 
 void Button_SetOnPressEvent(Button * const self, Button_OnPressEvent callback, void *userdata)
@@ -210,36 +227,56 @@ void Button_CallPressedEvent(Button * const self)
         self->pressedEvent.function(self, self->pressedEvent.userdata);
 }
 
-void Button_ProcessEvent(Button * const self, const SDL_Event *event)
+void Button_SetInputRouter(Button * const self, InputRouter *inputRouter)
+{
+    if (self->inputRouter)
+        InputRouter_RemoveTarget(self->inputRouter, self);
+
+    self->inputRouter = inputRouter;
+    self->state = Normal;
+
+    if (self->inputRouter)
+        InputRouter_AddTarget(self->inputRouter, self->box, Button_OnPointer, self);
+}
+
+void Button_OnPointer(void *userdata, InputRouter_Pointer pointer, const SDL_Event *event)
 {
-    if (event->type == SDL_MOUSEMOTION || event->type == SDL_MOUSEBUTTONDOWN || event->type == SDL_MOUSEBUTTONUP)
+    (void)event;
+
+    Button * const self = userdata;
+
+    switch (pointer)
     {
-        if (event->button.button == SDL_BUTTON_LEFT && Button_PointerIsHovering(self, event))
-        {
-            if (event->type == SDL_MOUSEBUTTONDOWN)
-            {
-                self->state = Pressed;
-
-                Button_CallPressedEvent(self);
-
-                return;
-            }
-            else if (self->state == Pressed && event->type != SDL_MOUSEBUTTONUP)
-            {
-                return;
-            }
-        }
-
-        if (Button_PointerIsHovering(self, event))
+    case InputRouter_PointerEnter:
+        self->state = Hover;
+        break;
+
+    case InputRouter_PointerLeave:
+        self->state = Normal;
+        break;
+
+    case InputRouter_PointerDown:
+        self->state = Pressed;
+        Button_CallPressedEvent(self);
+        break;
+
+    case InputRouter_PointerUp:
+        // Released outside already got the leave
+        if (self->state == Pressed)
             self->state = Hover;
-        else
-            self->state = Normal;
+        break;
     }
 }
 
 void Button_Draw(Button * const self)
 {
-    Button_OnUpdateBox(self);
+    if (self->textTexture)
+        Button_CenterContent(self, Texture_Box(self->textTexture), self->textTexture);
+
+    if (self->iconTexture)
+        Button_CenterContent(self, self->iconBox, self->iconTexture);
+
+    self->layoutDirty = false;
 
     if (self->state == Hover)
         Rectangle_SetColor(self->background, self->colorHover);
@@ -251,46 +288,37 @@ void Button_Draw(Button * const self)
     Rectangle_Draw(self->background);
 
     if (self->iconTexture)
-        Texture_Draw(self->iconTexture);
+        Texture_DrawRect(self->iconTexture, Box_Rect(self->iconBox));
 
     if (self->textTexture)
         Texture_Draw(self->textTexture);
 }
 
-bool Button_PointerIsHovering(Button * const self, const SDL_Event *event)
+// Only touches the box when the texture (loaded, reloaded, new text) or the button changed size
+void Button_CenterContent(Button * const self, Box *box, Texture *texture)
 {
-    const Rect *rect = Box_Rect(self->box);
+    const int w = Texture_GetWidth(texture);
+    const int h = Texture_GetHeight(texture);
 
-    return event->button.x >= rect->x
-            && event->button.x <= (rect->x + rect->w)
-            && event->button.y >= rect->y
-            && event->button.y <= (rect->y + rect->h);
-}
-
-void Button_OnUpdateBox(Button * const self)
-{
-    Texture *texture = self->textTexture ? self->textTexture : self->iconTexture;
-    const Rect *rect = Box_Rect(self->box);
-
-    if (texture)
-    {
-        Box *box = Texture_Box(texture);
-        int w = Texture_GetWidth(texture);
-        int h = Texture_GetHeight(texture);
+    if (!self->layoutDirty && w == Box_Width(box) && h == Box_Height(box))
+        return;
 
-        Box_SetSize(box, w, h);
-        Box_SetPosition(box, rect->x + ((rect->w - w) / 2), rect->y + ((rect->h - h) / 2));
-    }
+    Box_SetSize(box, w, h);
+    Box_SetPosition(box, (Box_Width(self->box) - w) / 2, (Box_Height(self->box) - h) / 2);
 }
 
 void Button_BoxOnUpdateEvent(Box * const box, void *userdata)
 {
+    (void)box;
+
     Button * const self = userdata;
 
+    // The children follow moves by themselves, only a new size changes the layout
     Box_SetSize(Rectangle_Box(self->background), Box_Width(self->box), Box_Height(self->box));
-    Box_SetPosition(Rectangle_Box(self->background), Box_X(self->box), Box_Y(self->box));
+    self->layoutDirty = true;
 
-    Button_OnUpdateBox(self);
+    if (self->inputRouter)
+        InputRouter_Invalidate(self->inputRouter);
 }
 
 Box *Button_Box(Button * const self)
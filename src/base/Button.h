@@ -32,9 +32,8 @@ SOFTWARE.
 extern "C" {
 #endif
 
-typedef union SDL_Event SDL_Event;
-
 typedef struct Texture Texture;
+typedef struct InputRouter InputRouter;
 typedef struct Button Button;
 
 typedef void (*Button_OnPressEvent)(Button * const button, void *user);
@@ -47,13 +46,15 @@ void Button_SetBackgroundHoverColorRGB(Button * const self, uint8_t r, uint8_t g
 void Button_SetBackgroundHoverColorRGBA(Button * const self, uint8_t r, uint8_t g, uint8_t b, uint8_t a);
 void Button_SetBackgroundPressedColorRGB(Button * const self, uint8_t r, uint8_t g, uint8_t b);
 void Button_SetBackgroundPressedColorRGBA(Button * const self, uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+void Button_SetBackgroundRadius(Button * const self, float radius);
 void Button_SetTextColorRGB(Button * const self, uint8_t r, uint8_t g, uint8_t b);
 void Button_SetTextColorRGBA(Button * const self, uint8_t r, uint8_t g, uint8_t b, uint8_t a);
 bool Button_SetText(Button * const self, const char *text, int ptsize);
 void Button_SetIcon(Button * const self, Texture *texture);
 void Button_SetOnPressEvent(Button * const self, Button_OnPressEvent callback, void *userdata);
 void *Button_GetEventUserData(Button * const self);
-void Button_ProcessEvent(Button * const self, const SDL_Event *event);
+// Receives pointer events from the router, NULL detaches it
+void Button_SetInputRouter(Button * const self, InputRouter *inputRouter);
 void Button_Draw(Button * const self);
 
 Box *Button_Box(Button * const self);
@@ -0,0 +1,72 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Cooked image (.tex), little-endian, written by tools/texcook:
+//   CookedImageHeader
+//   for each level, largest first: uint32_t size, then size bytes padded to 4
+// RGBA8 rows are tightly packed in R, G, B, A byte order, ready for glTexImage2D.
+// Compressed levels are rows of 4x4 blocks of 16 bytes, ready for glCompressedTexImage2D.
+// Next to images/<name>.png the game looks for <name>.etc2.tex and <name>.s3tc.tex when the GPU
+// samples that format, then for the RGBA8 <name>.tex
+
+#define COOKED_IMAGE_MAGIC 0x58545454 // "TTTX"
+#define COOKED_IMAGE_VERSION 1
+#define COOKED_IMAGE_MAX_LEVELS 16
+
+typedef enum CookedImageFormat
+{
+    CookedFormat_RGBA8 = 0,
+    CookedFormat_ETC2_RGBA8 = 1, // GL_COMPRESSED_RGBA8_ETC2_EAC
+    CookedFormat_S3TC_DXT5 = 2   // GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+} CookedImageFormat;
+
+typedef struct CookedImageHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t format;
+    uint32_t width;
+    uint32_t height;
+    uint32_t levels;
+} CookedImageHeader;
+
+static inline uint32_t CookedImage_LevelSize(uint32_t format, uint32_t width, uint32_t height)
+{
+    if (format == CookedFormat_RGBA8)
+        return width * height * 4;
+
+    return ((width + 3) / 4) * ((height + 3) / 4) * 16;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,69 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// data.pack layout, little-endian, written by tools/datapack:
+//   DataPackHeader
+//   DataPackEntry[count], sorted by name
+//   names, not null-terminated
+//   file data, each entry aligned to DATA_PACK_ALIGNMENT
+
+#define DATA_PACK_MAGIC 0x4b505454 // "TTPK"
+#define DATA_PACK_VERSION 1
+#define DATA_PACK_ALIGNMENT 16
+
+typedef enum DataPackCompression
+{
+    Compression_None = 0,
+    Compression_LZ4 = 1
+} DataPackCompression;
+
+typedef struct DataPackHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t namesOffset;
+} DataPackHeader;
+
+typedef struct DataPackEntry
+{
+    uint64_t offset;
+    uint32_t size; // stored size
+    uint32_t originalSize;
+    uint32_t nameOffset; // relative to namesOffset
+    uint16_t nameLength;
+    uint16_t compression;
+} DataPackEntry;
+
+#ifdef __cplusplus
+}
+#endif
@@ -26,13 +26,53 @@ SOFTWARE.
 
 #ifdef USE_DATA_ZIP
 
+#include "DataPackFormat.h"
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include <SDL2/SDL_rwops.h>
 #include <physfs.h>
 
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+// data.pack is mapped once, stored files are handed out as views into the mapping
+static struct
+{
+    const uint8_t *data;
+    size_t size;
+    const DataPackHeader *header;
+    const DataPackEntry *entries;
+    const char *names;
+
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+} pack;
+
+static bool OpenPack(const char *filename);
+static void ClosePack();
+static bool MapFile(const char *filename);
+static void UnmapFile();
+static const DataPackEntry *FindEntry(const char *filename);
+static bool ReadEntry(const DataPackEntry *entry, char *buffer);
+static bool DecompressLZ4(const uint8_t *src, size_t srcSize, uint8_t *dst, size_t dstSize);
+static SDL_RWops *RWFromOwnedMem(char *buffer, int size);
+
 bool DataZipFile_Init()
 {
+    if (OpenPack("data.pack"))
+        return true;
+
     if (!PHYSFS_init(NULL))
     {
         printf("Failure. reason: %s.\n", PHYSFS_getLastError());
@@ -53,11 +93,43 @@ bool DataZipFile_Init()
 
 void DataZipFile_Close()
 {
-    PHYSFS_deinit();
+    if (pack.data)
+        ClosePack();
+    else
+        PHYSFS_deinit();
+}
+
+bool DataZipFile_Exists(const char *filename)
+{
+    if (pack.data)
+        return FindEntry(filename) != NULL;
+
+    return PHYSFS_exists(filename);
 }
 
 int DataZipFile_Read(const char *filename, char **buffer)
 {
+    if (pack.data)
+    {
+        const DataPackEntry *entry = FindEntry(filename);
+
+        if (entry && entry->originalSize > 0)
+        {
+            *buffer = malloc(entry->originalSize);
+
+            if (ReadEntry(entry, *buffer))
+                return entry->originalSize;
+
+            free(*buffer);
+        }
+
+        printf("failed to open %s. Reason: [not found in data.pack].\n", filename);
+
+        *buffer = NULL;
+
+        return 0;
+    }
+
     PHYSFS_File *file = PHYSFS_openRead(filename);
 
     if (file)
@@ -90,13 +162,303 @@ int DataZipFile_Read(const char *filename, char **buffer)
 
 SDL_RWops *DataZipFile_Load_RW(const char *filename)
 {
+    if (pack.data)
+    {
+        const DataPackEntry *entry = FindEntry(filename);
+
+        // No copy and nothing to free, the view lives as long as the mapping
+        if (entry && entry->compression == Compression_None)
+            return SDL_RWFromConstMem(pack.data + entry->offset, entry->size);
+    }
+
     char *buffer;
     int size = DataZipFile_Read(filename, &buffer);
 
     if (size > 0)
-        return SDL_RWFromConstMem(buffer, size);
+        return RWFromOwnedMem(buffer, size);
+
+    return NULL;
+}
+
+bool OpenPack(const char *filename)
+{
+    if (!MapFile(filename))
+        return false;
+
+    if (pack.size < sizeof (DataPackHeader))
+    {
+        ClosePack();
+        return false;
+    }
+
+    pack.header = (const DataPackHeader *) pack.data;
+
+    const size_t entriesEnd = sizeof (DataPackHeader) + (size_t) pack.header->count * sizeof (DataPackEntry);
+
+    if (pack.header->magic != DATA_PACK_MAGIC
+            || pack.header->version != DATA_PACK_VERSION
+            || entriesEnd > pack.header->namesOffset
+            || pack.header->namesOffset > pack.size)
+    {
+        printf("data.pack is invalid or from another version.\n");
+        ClosePack();
+        return false;
+    }
+
+    pack.entries = (const DataPackEntry *) (pack.data + sizeof (DataPackHeader));
+    pack.names = (const char *) (pack.data + pack.header->namesOffset);
+
+    // Checked once here, so lookups can trust the index
+    for (uint32_t i = 0; i < pack.header->count; ++i)
+    {
+        const DataPackEntry *entry = &pack.entries[i];
+
+        if ((uint64_t) pack.header->namesOffset + entry->nameOffset + entry->nameLength > pack.size
+                || entry->offset > pack.size
+                || entry->size > pack.size - entry->offset
+                || entry->compression > Compression_LZ4
+                || (entry->compression == Compression_None && entry->size != entry->originalSize))
+        {
+            printf("data.pack is corrupted.\n");
+            ClosePack();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ClosePack()
+{
+    UnmapFile();
+
+    pack.data = NULL;
+    pack.size = 0;
+    pack.header = NULL;
+    pack.entries = NULL;
+    pack.names = NULL;
+}
+
+#ifdef _WIN32
+bool MapFile(const char *filename)
+{
+    pack.file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (pack.file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+
+    if (!GetFileSizeEx(pack.file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(pack.file);
+        return false;
+    }
+
+    pack.mapping = CreateFileMappingA(pack.file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+    if (!pack.mapping)
+    {
+        CloseHandle(pack.file);
+        return false;
+    }
+
+    pack.data = MapViewOfFile(pack.mapping, FILE_MAP_READ, 0, 0, 0);
+
+    if (!pack.data)
+    {
+        CloseHandle(pack.mapping);
+        CloseHandle(pack.file);
+        return false;
+    }
+
+    pack.size = size.QuadPart;
+
+    return true;
+}
+
+void UnmapFile()
+{
+    UnmapViewOfFile(pack.data);
+    CloseHandle(pack.mapping);
+    CloseHandle(pack.file);
+}
+#else
+bool MapFile(const char *filename)
+{
+    int fd = open(filename, O_RDONLY);
+
+    if (fd == -1)
+        return false;
+
+    struct stat st;
+
+    if (fstat(fd, &st) == -1 || st.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // The mapping keeps its own reference to the file
+    close(fd);
+
+    if (data == MAP_FAILED)
+        return false;
+
+    pack.data = data;
+    pack.size = st.st_size;
+
+    return true;
+}
+
+void UnmapFile()
+{
+    munmap((void *) pack.data, pack.size);
+}
+#endif
+
+const DataPackEntry *FindEntry(const char *filename)
+{
+    const size_t length = strlen(filename);
+    uint32_t first = 0;
+    uint32_t last = pack.header->count;
+
+    while (first < last)
+    {
+        const uint32_t middle = first + (last - first) / 2;
+        const DataPackEntry *entry = &pack.entries[middle];
+
+        const size_t common = entry->nameLength < length ? entry->nameLength : length;
+        int cmp = memcmp(pack.names + entry->nameOffset, filename, common);
+
+        if (cmp == 0)
+            cmp = (entry->nameLength > length) - (entry->nameLength < length);
+
+        if (cmp == 0)
+            return entry;
+
+        if (cmp < 0)
+            first = middle + 1;
+        else
+            last = middle;
+    }
 
     return NULL;
 }
 
+bool ReadEntry(const DataPackEntry *entry, char *buffer)
+{
+    const uint8_t *data = pack.data + entry->offset;
+
+    if (entry->compression == Compression_LZ4)
+        return DecompressLZ4(data, entry->size, (uint8_t *) buffer, entry->originalSize);
+
+    memcpy(buffer, data, entry->size);
+
+    return true;
+}
+
+bool DecompressLZ4(const uint8_t *src, size_t srcSize, uint8_t *dst, size_t dstSize)
+{
+    // LZ4 block format: sequences of literals followed by a back-reference
+    const uint8_t *ip = src;
+    const uint8_t * const ipEnd = src + srcSize;
+    uint8_t *op = dst;
+    uint8_t * const opEnd = dst + dstSize;
+
+    while (ip < ipEnd)
+    {
+        const uint8_t token = *ip++;
+        size_t length = token >> 4;
+
+        if (length == 15)
+        {
+            uint8_t byte;
+
+            do
+            {
+                if (ip >= ipEnd)
+                    return false;
+
+                byte = *ip++;
+                length += byte;
+            }
+            while (byte == 255);
+        }
+
+        if (length > (size_t) (ipEnd - ip) || length > (size_t) (opEnd - op))
+            return false;
+
+        memcpy(op, ip, length);
+        ip += length;
+        op += length;
+
+        // The last sequence only has literals
+        if (ip == ipEnd)
+            break;
+
+        if (ipEnd - ip < 2)
+            return false;
+
+        const size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+
+        if (offset == 0 || offset > (size_t) (op - dst))
+            return false;
+
+        length = token & 15;
+
+        if (length == 15)
+        {
+            uint8_t byte;
+
+            do
+            {
+                if (ip >= ipEnd)
+                    return false;
+
+                byte = *ip++;
+                length += byte;
+            }
+            while (byte == 255);
+        }
+
+        length += 4;
+
+        if (length > (size_t) (opEnd - op))
+            return false;
+
+        // Byte by byte, the match may overlap the output
+        const uint8_t *match = op - offset;
+
+        while (length--)
+            *op++ = *match++;
+    }
+
+    return op == opEnd;
+}
+
+static int SDLCALL CloseOwnedMem(SDL_RWops *context)
+{
+    free(context->hidden.mem.base);
+    SDL_FreeRW(context);
+
+    return 0;
+}
+
+SDL_RWops *RWFromOwnedMem(char *buffer, int size)
+{
+    // SDL_RWFromConstMem does not own the buffer, it is freed when the RWops is closed
+    SDL_RWops *rw = SDL_RWFromConstMem(buffer, size);
+
+    if (rw)
+        rw->close = CloseOwnedMem;
+    else
+        free(buffer);
+
+    return rw;
+}
+
 #endif // USE_DATA_ZIP
@@ -26,7 +26,7 @@ SOFTWARE.
 
 #ifdef USE_DATA_ZIP
 
-typedef struct SDL_RWops SDL_RWops
+typedef struct SDL_RWops SDL_RWops;
 
 #include <stdbool.h>
 
@@ -34,9 +34,13 @@ typedef struct SDL_RWops SDL_RWops
 extern "C" {
 #endif
 
+// Uses the memory-mapped data.pack when present, data.zip through PhysicsFS otherwise
 bool DataZipFile_Init();
 void DataZipFile_Close();
+bool DataZipFile_Exists(const char *filename);
 int DataZipFile_Read(const char *filename, char **buffer);
+
+// The returned RWops must be closed, no data is copied for files stored uncompressed in data.pack
 SDL_RWops *DataZipFile_Load_RW(const char *filename);
 
 #ifdef __cplusplus
@@ -0,0 +1,136 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#include "DynamicResolution.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+// The scale moves in steps of this size, so the framebuffer isn't recreated for every small change
+static const float ScaleStep = 0.05f;
+// Weight of the newest frame in the average GPU time
+static const double AverageWeight = 0.1;
+
+// Over this share of the budget for OverFrames frames the scale drops, aiming at TargetShare of it
+static const double OverShare = 0.95;
+static const int OverFrames = 8;
+static const double TargetShare = 0.85;
+// Under this share of the budget for UnderFrames frames the scale rises one step
+static const double UnderShare = 0.70;
+static const int UnderFrames = 60;
+// Frames ignored after a change, while the average catches up with the new scale
+static const int CooldownFrames = 30;
+
+struct DynamicResolution
+{
+    double budget;
+    double average;
+    float scale;
+    float minScale;
+    float maxScale;
+    int overCount;
+    int underCount;
+    int cooldown;
+};
+
+static float ClampScale(DynamicResolution * const self, float scale);
+static void SetScale(DynamicResolution * const self, float scale);
+
+DynamicResolution *DynamicResolution_New(double budgetSeconds, float minScale, float maxScale)
+{
+    DynamicResolution * const self = malloc(sizeof (DynamicResolution));
+
+    self->budget = budgetSeconds;
+    self->average = 0.0;
+    self->minScale = minScale;
+    self->maxScale = maxScale;
+    self->scale = maxScale;
+    self->overCount = 0;
+    self->underCount = 0;
+    self->cooldown = 0;
+
+    return self;
+}
+
+void DynamicResolution_Delete(DynamicResolution * const self)
+{
+    free(self);
+}
+
+float DynamicResolution_Update(DynamicResolution * const self, double gpuSeconds)
+{
+    if (self->average == 0.0)
+        self->average = gpuSeconds;
+    else
+        self->average += (gpuSeconds - self->average) * AverageWeight;
+
+    if (self->cooldown > 0)
+    {
+        self->cooldown--;
+        return self->scale;
+    }
+
+    self->overCount = self->average > self->budget * OverShare ? self->overCount + 1 : 0;
+    self->underCount = self->average < self->budget * UnderShare ? self->underCount + 1 : 0;
+
+    if (self->overCount >= OverFrames)
+    {
+        // GPU time goes with the number of pixels, the square of the scale
+        float scale = self->scale * sqrt(self->budget * TargetShare / self->average);
+
+        SetScale(self, fminf(scale, self->scale - ScaleStep));
+    }
+    else if (self->underCount >= UnderFrames)
+        SetScale(self, self->scale + ScaleStep);
+
+    return self->scale;
+}
+
+float DynamicResolution_Scale(DynamicResolution * const self)
+{
+    return self->scale;
+}
+
+float ClampScale(DynamicResolution * const self, float scale)
+{
+    scale = roundf(scale / ScaleStep) * ScaleStep;
+
+    return fminf(fmaxf(scale, self->minScale), self->maxScale);
+}
+
+void SetScale(DynamicResolution * const self, float scale)
+{
+    scale = ClampScale(self, scale);
+
+    self->overCount = 0;
+    self->underCount = 0;
+
+    if (scale == self->scale)
+        return;
+
+    // The average is of frames at the old scale, scale it to the new one
+    self->average *= (scale * scale) / (self->scale * self->scale);
+    self->scale = scale;
+    self->cooldown = CooldownFrames;
+}
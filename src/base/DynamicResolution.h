@@ -0,0 +1,46 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct DynamicResolution DynamicResolution;
+
+// Picks a render scale that keeps the GPU time of a frame under a budget.
+// The scale drops as soon as a few frames run over and climbs back one step at a time after a long
+// stretch well under, with a cooldown after each change, so it doesn't oscillate around the budget
+
+DynamicResolution *DynamicResolution_New(double budgetSeconds, float minScale, float maxScale);
+void DynamicResolution_Delete(DynamicResolution * const self);
+
+// Feeds the GPU time of a frame, returns the scale to render the next ones at
+float DynamicResolution_Update(DynamicResolution * const self, double gpuSeconds);
+float DynamicResolution_Scale(DynamicResolution * const self);
+
+#ifdef __cplusplus
+}
+#endif
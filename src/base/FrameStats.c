@@ -0,0 +1,167 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#include "FrameStats.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define BUCKETS_PER_OCTAVE 4
+#define BUCKET_COUNT 64
+
+// Upper bound of the first bucket, in milliseconds
+static const double FirstBucketMs = 1.0 / 16.0;
+
+static const char *PassNames[_FrameStats_PassCount] = {
+    "events",
+    "timers and assets",
+    "update",
+    "draw",
+    "flush",
+    "present",
+};
+
+struct FrameStats
+{
+    uint64_t buckets[BUCKET_COUNT];
+    uint64_t count;
+    double totalMs;
+    double minMs;
+    double maxMs;
+    double passTotalMs[_FrameStats_PassCount];
+};
+
+static double BucketUpperMs(int bucket);
+static double PercentileMs(FrameStats * const self, double percentile);
+
+FrameStats *FrameStats_New()
+{
+    FrameStats * const self = malloc(sizeof (FrameStats));
+
+    FrameStats_Clear(self);
+
+    return self;
+}
+
+void FrameStats_Delete(FrameStats * const self)
+{
+    free(self);
+}
+
+void FrameStats_Add(FrameStats * const self, double seconds)
+{
+    const double ms = seconds * 1000.0;
+    int bucket = 0;
+
+    if (ms > FirstBucketMs)
+        bucket = ceil(log2(ms / FirstBucketMs) * BUCKETS_PER_OCTAVE);
+
+    if (bucket >= BUCKET_COUNT)
+        bucket = BUCKET_COUNT - 1;
+
+    self->buckets[bucket]++;
+    self->count++;
+    self->totalMs += ms;
+
+    if (ms < self->minMs)
+        self->minMs = ms;
+
+    if (ms > self->maxMs)
+        self->maxMs = ms;
+}
+
+void FrameStats_AddPass(FrameStats * const self, FrameStats_Pass pass, double seconds)
+{
+    self->passTotalMs[pass] += seconds * 1000.0;
+}
+
+void FrameStats_Clear(FrameStats * const self)
+{
+    for (int i = 0; i < BUCKET_COUNT; ++i)
+        self->buckets[i] = 0;
+
+    for (int i = 0; i < _FrameStats_PassCount; ++i)
+        self->passTotalMs[i] = 0.0;
+
+    self->count = 0;
+    self->totalMs = 0.0;
+    self->minMs = INFINITY;
+    self->maxMs = 0.0;
+}
+
+void FrameStats_Print(FrameStats * const self, FILE *file)
+{
+    if (self->count == 0)
+    {
+        fprintf(file, "frames: 0\n");
+        return;
+    }
+
+    fprintf(file, "frames: %llu, %.1f fps, mean %.3f ms, min %.3f ms, p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, max %.3f ms\n",
+            (unsigned long long) self->count,
+            1000.0 * self->count / self->totalMs,
+            self->totalMs / self->count,
+            self->minMs,
+            PercentileMs(self, 0.5),
+            PercentileMs(self, 0.9),
+            PercentileMs(self, 0.99),
+            self->maxMs);
+
+    fprintf(file, "pass means:");
+
+    for (int i = 0; i < _FrameStats_PassCount; ++i)
+        fprintf(file, "%s %s %.3f ms", i ? "," : "", PassNames[i], self->passTotalMs[i] / self->count);
+
+    fprintf(file, "\n");
+
+    for (int i = 0; i < BUCKET_COUNT; ++i)
+        if (self->buckets[i])
+            fprintf(file, "  <= %9.3f ms %10llu %6.2f%%\n",
+                    BucketUpperMs(i),
+                    (unsigned long long) self->buckets[i],
+                    100.0 * self->buckets[i] / self->count);
+}
+
+double BucketUpperMs(int bucket)
+{
+    return FirstBucketMs * exp2((double) bucket / BUCKETS_PER_OCTAVE);
+}
+
+// Upper bound of the bucket holding the percentile, clamped to the measured range
+double PercentileMs(FrameStats * const self, double percentile)
+{
+    const uint64_t rank = ceil(percentile * self->count);
+    uint64_t seen = 0;
+
+    for (int i = 0; i < BUCKET_COUNT; ++i)
+    {
+        seen += self->buckets[i];
+
+        if (seen >= rank)
+            return fmax(fmin(BucketUpperMs(i), self->maxMs), self->minMs);
+    }
+
+    return self->maxMs;
+}
@@ -0,0 +1,61 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FrameStats FrameStats;
+
+// Parts of a frame of the main loop, timed on the CPU
+typedef enum FrameStats_Pass
+{
+    FrameStats_Events = 0,
+    FrameStats_TimersAndAssets = 1,
+    FrameStats_Update = 2,
+    FrameStats_Draw = 3,
+    FrameStats_Flush = 4,
+    FrameStats_Present = 5,
+    _FrameStats_PassCount = 6
+} FrameStats_Pass;
+
+// Histogram of frame times with four buckets per octave, from 1/16 ms to about 3.4 s.
+// Adding a frame is a couple of arithmetic operations, so it's always on
+
+FrameStats *FrameStats_New();
+void FrameStats_Delete(FrameStats * const self);
+
+void FrameStats_Add(FrameStats * const self, double seconds);
+void FrameStats_AddPass(FrameStats * const self, FrameStats_Pass pass, double seconds);
+void FrameStats_Clear(FrameStats * const self);
+// A summary line with percentiles, the mean of each pass, then one line per non-empty bucket
+void FrameStats_Print(FrameStats * const self, FILE *file);
+
+#ifdef __cplusplus
+}
+#endif
@@ -49,8 +49,7 @@ Graphics *Graphics_New(Window *window)
         exit(-1);
     }
 
-    IVec2 size = Window_GetSize(window);
-    SetRenderLogicalSize(self, size.w, size.h);
+    Graphics_Resize(self, Window_GetSize(window), Window_GetDrawableSize(window));
 
     return self;
 }
@@ -77,3 +76,10 @@ int SetRenderLogicalSize(Graphics * const self, int w, int h)
 
     return 1;
 }
+
+void Graphics_Resize(Graphics * const self, IVec2 size, IVec2 drawableSize)
+{
+    // Drawing stays in points, the viewport covers every pixel of the drawable
+    OpenGLRenderer_SetLogicalSize(self->renderer, size.w, size.h);
+    OpenGLRenderer_SetViewportSize(self->renderer, drawableSize.w, drawableSize.h);
+}
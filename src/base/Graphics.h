@@ -37,6 +37,7 @@ Graphics *Graphics_New(Window *window);
 void Graphics_Delete(Graphics * const self);
 OpenGLRenderer *Graphics_GetRenderer(Graphics * const self);
 int SetRenderLogicalSize(Graphics * const self, int w, int h);
+void Graphics_Resize(Graphics * const self, IVec2 size, IVec2 drawableSize);
 
 #ifdef __cplusplus
 }
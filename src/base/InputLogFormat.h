@@ -0,0 +1,67 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Input log layout, written by InputRecorder and read by InputReplay:
+//   InputLogHeader
+//   records, each one:
+//     varint frames since the previous record
+//     varint milliseconds since the previous record, zigzag
+//     uint8_t InputLogKind
+//     the payload of the kind, varints (zigzag when signed) and bytes
+// Every frame starts with an InputLog_Frame record, so a replay advances its clock exactly as the
+// recording did. InputLog_End closes the log, a log cut short ends at its last complete record
+
+#define INPUT_LOG_MAGIC 0x49545454 // "TTTI"
+#define INPUT_LOG_VERSION 2
+
+typedef enum InputLogKind
+{
+    InputLog_End = 0,
+    InputLog_MouseMotion = 1,     // x, y, xrel, yrel, state
+    InputLog_MouseButtonDown = 2, // button byte, clicks byte, x, y
+    InputLog_MouseButtonUp = 3,   // button byte, clicks byte, x, y
+    InputLog_MouseWheel = 4,      // x, y, direction
+    InputLog_KeyDown = 5,         // scancode, sym, mod, repeat byte
+    InputLog_KeyUp = 6,           // scancode, sym, mod, repeat byte
+    InputLog_Window = 7,          // event byte, data1, data2
+    InputLog_Frame = 8            // microseconds the clock advanced on this frame
+} InputLogKind;
+
+typedef struct InputLogHeader
+{
+    uint32_t magic;
+    uint32_t version;
+} InputLogHeader;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,216 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#include "InputRecorder.h"
+#include "InputLogFormat.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <SDL2/SDL.h>
+
+// Largest record is well under this, so a record never straddles a flush
+#define MAX_RECORD_SIZE 128
+#define BUFFER_SIZE 4096
+
+struct InputRecorder
+{
+    SDL_RWops *file;
+    uint64_t lastFrame;
+    uint32_t lastTimestamp;
+    bool finished;
+
+    size_t used;
+    uint8_t buffer[BUFFER_SIZE];
+};
+
+static void BeginRecord(InputRecorder * const self, uint64_t frame, uint32_t timestamp, InputLogKind kind);
+static void Flush(InputRecorder * const self);
+static void PutByte(InputRecorder * const self, uint8_t value);
+static void PutVarint(InputRecorder * const self, uint64_t value);
+static void PutSigned(InputRecorder * const self, int64_t value);
+
+InputRecorder *InputRecorder_New(const char *filename)
+{
+    SDL_RWops *file = SDL_RWFromFile(filename, "wb");
+
+    if (!file)
+    {
+        printf("Unable to create the input log %s: %s\n", filename, SDL_GetError());
+        return NULL;
+    }
+
+    const InputLogHeader header = {INPUT_LOG_MAGIC, INPUT_LOG_VERSION};
+
+    if (SDL_RWwrite(file, &header, sizeof (header), 1) != 1)
+    {
+        printf("Unable to write the input log %s: %s\n", filename, SDL_GetError());
+        SDL_RWclose(file);
+        return NULL;
+    }
+
+    InputRecorder * const self = malloc(sizeof (InputRecorder));
+
+    self->file = file;
+    self->lastFrame = 0;
+    self->lastTimestamp = 0;
+    self->finished = false;
+    self->used = 0;
+
+    return self;
+}
+
+void InputRecorder_Delete(InputRecorder * const self)
+{
+    if (!self)
+        return;
+
+    Flush(self);
+    SDL_RWclose(self->file);
+    free(self);
+}
+
+double InputRecorder_RecordFrame(InputRecorder * const self, uint64_t frame, double deltaTime)
+{
+    const uint64_t microseconds = llround(deltaTime * 1000000.0);
+
+    if (!self->finished)
+    {
+        BeginRecord(self, frame, self->lastTimestamp, InputLog_Frame);
+        PutVarint(self, microseconds);
+    }
+
+    return microseconds / 1000000.0;
+}
+
+void InputRecorder_Record(InputRecorder * const self, uint64_t frame, const SDL_Event *event)
+{
+    if (self->finished)
+        return;
+
+    switch (event->type)
+    {
+    case SDL_MOUSEMOTION:
+        BeginRecord(self, frame, event->motion.timestamp, InputLog_MouseMotion);
+        PutSigned(self, event->motion.x);
+        PutSigned(self, event->motion.y);
+        PutSigned(self, event->motion.xrel);
+        PutSigned(self, event->motion.yrel);
+        PutVarint(self, event->motion.state);
+        break;
+
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+        BeginRecord(self, frame, event->button.timestamp,
+                    event->type == SDL_MOUSEBUTTONDOWN ? InputLog_MouseButtonDown : InputLog_MouseButtonUp);
+        PutByte(self, event->button.button);
+        PutByte(self, event->button.clicks);
+        PutSigned(self, event->button.x);
+        PutSigned(self, event->button.y);
+        break;
+
+    case SDL_MOUSEWHEEL:
+        BeginRecord(self, frame, event->wheel.timestamp, InputLog_MouseWheel);
+        PutSigned(self, event->wheel.x);
+        PutSigned(self, event->wheel.y);
+        PutVarint(self, event->wheel.direction);
+        break;
+
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+        BeginRecord(self, frame, event->key.timestamp, event->type == SDL_KEYDOWN ? InputLog_KeyDown : InputLog_KeyUp);
+        PutVarint(self, event->key.keysym.scancode);
+        PutSigned(self, event->key.keysym.sym);
+        PutVarint(self, event->key.keysym.mod);
+        PutByte(self, event->key.repeat);
+        break;
+
+    case SDL_WINDOWEVENT:
+        BeginRecord(self, frame, event->window.timestamp, InputLog_Window);
+        PutByte(self, event->window.event);
+        PutSigned(self, event->window.data1);
+        PutSigned(self, event->window.data2);
+        break;
+
+    default:
+        break;
+    }
+}
+
+void InputRecorder_Finish(InputRecorder * const self, uint64_t frame)
+{
+    if (self->finished)
+        return;
+
+    BeginRecord(self, frame, self->lastTimestamp, InputLog_End);
+    Flush(self);
+    self->finished = true;
+}
+
+void BeginRecord(InputRecorder * const self, uint64_t frame, uint32_t timestamp, InputLogKind kind)
+{
+    if (self->used > BUFFER_SIZE - MAX_RECORD_SIZE)
+        Flush(self);
+
+    PutVarint(self, frame - self->lastFrame);
+    PutSigned(self, (int64_t) timestamp - self->lastTimestamp);
+    PutByte(self, kind);
+
+    self->lastFrame = frame;
+    self->lastTimestamp = timestamp;
+}
+
+void Flush(InputRecorder * const self)
+{
+    if (self->used == 0)
+        return;
+
+    if (SDL_RWwrite(self->file, self->buffer, self->used, 1) != 1)
+        printf("Unable to write the input log: %s\n", SDL_GetError());
+
+    self->used = 0;
+}
+
+void PutByte(InputRecorder * const self, uint8_t value)
+{
+    self->buffer[self->used++] = value;
+}
+
+void PutVarint(InputRecorder * const self, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        PutByte(self, (value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+
+    PutByte(self, value);
+}
+
+void PutSigned(InputRecorder * const self, int64_t value)
+{
+    PutVarint(self, ((uint64_t) value << 1) ^ (uint64_t) (value >> 63));
+}
@@ -0,0 +1,54 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef union SDL_Event SDL_Event;
+
+typedef struct InputRecorder InputRecorder;
+
+// Writes input events to a compact binary log (InputLogFormat.h), buffered so it can stay on in
+// release builds. Events that are not input are skipped
+
+// NULL if the file can't be created
+InputRecorder *InputRecorder_New(const char *filename);
+// Flushes the log, a log that was not finished still replays up to its last event
+void InputRecorder_Delete(InputRecorder * const self);
+
+// Records the clock step of the frame, called before its events. Returns the step rounded to the
+// microseconds the log keeps, which the session must advance by to match its replay
+double InputRecorder_RecordFrame(InputRecorder * const self, uint64_t frame, double deltaTime);
+void InputRecorder_Record(InputRecorder * const self, uint64_t frame, const SDL_Event *event);
+// Marks the frame the session ended on, nothing is recorded afterwards
+void InputRecorder_Finish(InputRecorder * const self, uint64_t frame);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,262 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#include "InputReplay.h"
+#include "InputLogFormat.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL2/SDL.h>
+
+struct InputReplay
+{
+    uint8_t *data;
+    size_t size;
+    size_t position;
+    bool corrupt;
+
+    // The record at position, its header already read
+    InputLogKind kind;
+    uint64_t frame;
+    uint32_t timestamp;
+};
+
+static void ReadRecordHeader(InputReplay * const self);
+static uint8_t GetByte(InputReplay * const self);
+static uint64_t GetVarint(InputReplay * const self);
+static int64_t GetSigned(InputReplay * const self);
+
+InputReplay *InputReplay_New(const char *filename)
+{
+    SDL_RWops *file = SDL_RWFromFile(filename, "rb");
+
+    if (!file)
+    {
+        printf("Unable to open the input log %s: %s\n", filename, SDL_GetError());
+        return NULL;
+    }
+
+    const Sint64 size = SDL_RWsize(file);
+    InputLogHeader header;
+
+    if (size < (Sint64) sizeof (header)
+            || SDL_RWread(file, &header, sizeof (header), 1) != 1
+            || header.magic != INPUT_LOG_MAGIC
+            || header.version != INPUT_LOG_VERSION)
+    {
+        printf("%s is not an input log\n", filename);
+        SDL_RWclose(file);
+        return NULL;
+    }
+
+    InputReplay * const self = malloc(sizeof (InputReplay));
+
+    self->size = size - sizeof (header);
+    self->data = malloc(self->size ? self->size : 1);
+    self->position = 0;
+    self->corrupt = false;
+    self->frame = 0;
+    self->timestamp = 0;
+
+    if (self->size && SDL_RWread(file, self->data, self->size, 1) != 1)
+    {
+        printf("Unable to read the input log %s: %s\n", filename, SDL_GetError());
+        self->size = 0;
+    }
+
+    SDL_RWclose(file);
+
+    ReadRecordHeader(self);
+
+    return self;
+}
+
+void InputReplay_Delete(InputReplay * const self)
+{
+    if (!self)
+        return;
+
+    free(self->data);
+    free(self);
+}
+
+bool InputReplay_FrameTime(InputReplay * const self, uint64_t frame, double *deltaTime)
+{
+    if (self->kind != InputLog_Frame || self->frame != frame)
+        return false;
+
+    *deltaTime = GetVarint(self) / 1000000.0;
+    ReadRecordHeader(self);
+
+    return !self->corrupt;
+}
+
+bool InputReplay_Next(InputReplay * const self, uint64_t frame, SDL_Event *event)
+{
+    double deltaTime;
+
+    // A frame step nobody asked for is skipped
+    if (InputReplay_FrameTime(self, frame, &deltaTime))
+        return InputReplay_Next(self, frame, event);
+
+    if (self->kind == InputLog_End || self->frame != frame)
+        return false;
+
+    memset(event, 0, sizeof (SDL_Event));
+
+    switch (self->kind)
+    {
+    case InputLog_MouseMotion:
+        event->motion.type = SDL_MOUSEMOTION;
+        event->motion.timestamp = self->timestamp;
+        event->motion.x = GetSigned(self);
+        event->motion.y = GetSigned(self);
+        event->motion.xrel = GetSigned(self);
+        event->motion.yrel = GetSigned(self);
+        event->motion.state = GetVarint(self);
+        break;
+
+    case InputLog_MouseButtonDown:
+    case InputLog_MouseButtonUp:
+        event->button.type = self->kind == InputLog_MouseButtonDown ? SDL_MOUSEBUTTONDOWN : SDL_MOUSEBUTTONUP;
+        event->button.timestamp = self->timestamp;
+        event->button.state = self->kind == InputLog_MouseButtonDown ? SDL_PRESSED : SDL_RELEASED;
+        event->button.button = GetByte(self);
+        event->button.clicks = GetByte(self);
+        event->button.x = GetSigned(self);
+        event->button.y = GetSigned(self);
+        break;
+
+    case InputLog_MouseWheel:
+        event->wheel.type = SDL_MOUSEWHEEL;
+        event->wheel.timestamp = self->timestamp;
+        event->wheel.x = GetSigned(self);
+        event->wheel.y = GetSigned(self);
+        event->wheel.direction = GetVarint(self);
+        break;
+
+    case InputLog_KeyDown:
+    case InputLog_KeyUp:
+        event->key.type = self->kind == InputLog_KeyDown ? SDL_KEYDOWN : SDL_KEYUP;
+        event->key.timestamp = self->timestamp;
+        event->key.state = self->kind == InputLog_KeyDown ? SDL_PRESSED : SDL_RELEASED;
+        event->key.keysym.scancode = GetVarint(self);
+        event->key.keysym.sym = GetSigned(self);
+        event->key.keysym.mod = GetVarint(self);
+        event->key.repeat = GetByte(self);
+        break;
+
+    case InputLog_Window:
+        event->window.type = SDL_WINDOWEVENT;
+        event->window.timestamp = self->timestamp;
+        event->window.event = GetByte(self);
+        event->window.data1 = GetSigned(self);
+        event->window.data2 = GetSigned(self);
+        break;
+
+    default:
+        printf("Unknown input log record %d\n", self->kind);
+        self->corrupt = true;
+        break;
+    }
+
+    ReadRecordHeader(self);
+
+    // A record cut short is dropped, the log ends before it
+    return !self->corrupt;
+}
+
+bool InputReplay_IsFinished(InputReplay * const self, uint64_t frame)
+{
+    if (self->kind == InputLog_Frame && self->frame == frame)
+    {
+        // Looks past the step of the frame, the session may have ended on it
+        const InputReplay current = *self;
+
+        GetVarint(self);
+        ReadRecordHeader(self);
+
+        const bool finished = self->kind == InputLog_End && frame >= self->frame;
+
+        *self = current;
+
+        return finished;
+    }
+
+    return self->kind == InputLog_End && frame >= self->frame;
+}
+
+void ReadRecordHeader(InputReplay * const self)
+{
+    if (self->position >= self->size)
+    {
+        // Not finished by the recorder, ends right after the last event
+        self->kind = InputLog_End;
+        return;
+    }
+
+    self->frame += GetVarint(self);
+    self->timestamp += GetSigned(self);
+    self->kind = GetByte(self);
+
+    if (self->corrupt)
+        self->kind = InputLog_End;
+}
+
+uint8_t GetByte(InputReplay * const self)
+{
+    if (self->position >= self->size)
+    {
+        self->corrupt = true;
+        return 0;
+    }
+
+    return self->data[self->position++];
+}
+
+uint64_t GetVarint(InputReplay * const self)
+{
+    uint64_t value = 0;
+
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        const uint8_t byte = GetByte(self);
+
+        value |= (uint64_t) (byte & 0x7f) << shift;
+
+        if (!(byte & 0x80))
+            break;
+    }
+
+    return value;
+}
+
+int64_t GetSigned(InputReplay * const self)
+{
+    const uint64_t value = GetVarint(self);
+
+    return (int64_t) (value >> 1) ^ -(int64_t) (value & 1);
+}
@@ -0,0 +1,53 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef union SDL_Event SDL_Event;
+
+typedef struct InputReplay InputReplay;
+
+// Plays an InputRecorder log back, event by event, on the same frames they were recorded
+
+// NULL if the file can't be read or isn't an input log
+InputReplay *InputReplay_New(const char *filename);
+void InputReplay_Delete(InputReplay * const self);
+
+// Sets deltaTime to the clock step recorded for this frame, false if it has none
+bool InputReplay_FrameTime(InputReplay * const self, uint64_t frame, double *deltaTime);
+// Fills event with the next event of this frame, false when the frame has no more
+bool InputReplay_Next(InputReplay * const self, uint64_t frame, SDL_Event *event);
+// True once the frame the session ended on is reached
+bool InputReplay_IsFinished(InputReplay * const self, uint64_t frame);
+
+#ifdef __cplusplus
+}
+#endif
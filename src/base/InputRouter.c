@@ -0,0 +1,313 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#include "InputRouter.h"
+#include "Box.h"
+#include "Vector.h"
+#include "rect.h"
+
+#include <math.h>
+#include <string.h>
+
+#include <SDL2/SDL_events.h>
+
+// Side of a grid cell in pixels, a hit test only looks at the targets overlapping one cell
+static const float CellSize = 64.f;
+
+typedef struct InputTarget
+{
+    Box *box;
+    InputRouter_PointerHandler handler;
+    void *userdata;
+} InputTarget;
+
+VECTOR_TYPE(InputTargets, InputTarget)
+VECTOR_TYPE(InputIndices, int)
+
+struct InputRouter
+{
+    InputTargets targets;
+
+    // The targets overlapping cell i are cellTargets[cellStart[i]] up to cellTargets[cellStart[i + 1]],
+    // in the order they were added
+    InputIndices cellStart;
+    InputIndices cellTargets;
+    int columns;
+    int rows;
+    bool dirty;
+
+    int hovered;
+    int captured;
+};
+
+static void Rebuild(InputRouter * const self);
+static bool CellRange(const Rect *rect, int *col0, int *row0, int *col1, int *row1);
+static int HitTest(InputRouter * const self, int x, int y);
+static bool Contains(InputRouter * const self, int index, int x, int y);
+static void PointerMoved(InputRouter * const self, int x, int y, const SDL_Event *event);
+static void SetHovered(InputRouter * const self, int index, const SDL_Event *event);
+static void Send(InputRouter * const self, int index, InputRouter_Pointer pointer, const SDL_Event *event);
+
+InputRouter *InputRouter_New()
+{
+    InputRouter * const self = malloc(sizeof (InputRouter));
+
+    InputTargets_Init(&self->targets);
+    InputIndices_Init(&self->cellStart);
+    InputIndices_Init(&self->cellTargets);
+    self->columns = 0;
+    self->rows = 0;
+    self->dirty = true;
+    self->hovered = -1;
+    self->captured = -1;
+
+    return self;
+}
+
+void InputRouter_Delete(InputRouter * const self)
+{
+    if (!self)
+        return;
+
+    InputTargets_Free(&self->targets);
+    InputIndices_Free(&self->cellStart);
+    InputIndices_Free(&self->cellTargets);
+    free(self);
+}
+
+void InputRouter_AddTarget(InputRouter * const self, Box *box, InputRouter_PointerHandler handler, void *userdata)
+{
+    *InputTargets_Push(&self->targets) = (InputTarget) {box, handler, userdata};
+    self->dirty = true;
+}
+
+void InputRouter_RemoveTarget(InputRouter * const self, void *userdata)
+{
+    for (int i = 0; i < (int) self->targets.size; ++i)
+    {
+        if (self->targets.data[i].userdata != userdata)
+            continue;
+
+        InputTargets_Remove(&self->targets, i);
+
+        // Handlers may remove targets while an event is being routed, the indexes are kept valid
+        if (self->hovered == i)
+            self->hovered = -1;
+        else if (self->hovered > i)
+            --self->hovered;
+
+        if (self->captured == i)
+            self->captured = -1;
+        else if (self->captured > i)
+            --self->captured;
+
+        self->dirty = true;
+
+        return;
+    }
+}
+
+void InputRouter_Clear(InputRouter * const self)
+{
+    InputTargets_Clear(&self->targets);
+    self->hovered = -1;
+    self->captured = -1;
+    self->dirty = true;
+}
+
+void InputRouter_Invalidate(InputRouter * const self)
+{
+    self->dirty = true;
+}
+
+bool InputRouter_ProcessEvent(InputRouter * const self, const SDL_Event *event)
+{
+    switch (event->type)
+    {
+    case SDL_MOUSEMOTION:
+        PointerMoved(self, event->motion.x, event->motion.y, event);
+        return true;
+
+    case SDL_MOUSEBUTTONDOWN:
+        PointerMoved(self, event->button.x, event->button.y, event);
+
+        if (event->button.button == SDL_BUTTON_LEFT && self->captured < 0 && self->hovered >= 0)
+        {
+            self->captured = self->hovered;
+            Send(self, self->captured, InputRouter_PointerDown, event);
+        }
+
+        return true;
+
+    case SDL_MOUSEBUTTONUP:
+        if (event->button.button == SDL_BUTTON_LEFT && self->captured >= 0)
+        {
+            const int captured = self->captured;
+
+            self->captured = -1;
+            Send(self, captured, InputRouter_PointerUp, event);
+        }
+
+        PointerMoved(self, event->button.x, event->button.y, event);
+
+        return true;
+
+    case SDL_WINDOWEVENT:
+        if (event->window.event == SDL_WINDOWEVENT_LEAVE && self->captured < 0)
+            SetHovered(self, -1, event);
+
+        return false;
+
+    default:
+        return false;
+    }
+}
+
+void Rebuild(InputRouter * const self)
+{
+    int col0, row0, col1, row1;
+
+    self->columns = 0;
+    self->rows = 0;
+    self->dirty = false;
+
+    for (size_t i = 0; i < self->targets.size; ++i)
+    {
+        if (!CellRange(Box_Rect(self->targets.data[i].box), &col0, &row0, &col1, &row1))
+            continue;
+
+        if (col1 >= self->columns)
+            self->columns = col1 + 1;
+
+        if (row1 >= self->rows)
+            self->rows = row1 + 1;
+    }
+
+    const int cells = self->columns * self->rows;
+
+    InputIndices_Resize(&self->cellStart, cells + 1);
+    memset(self->cellStart.data, 0, (cells + 1) * sizeof (int));
+
+    // Counts the targets of each cell, then turns the counts into offsets
+    for (size_t i = 0; i < self->targets.size; ++i)
+        if (CellRange(Box_Rect(self->targets.data[i].box), &col0, &row0, &col1, &row1))
+            for (int row = row0; row <= row1; ++row)
+                for (int col = col0; col <= col1; ++col)
+                    ++self->cellStart.data[row * self->columns + col + 1];
+
+    for (int cell = 0; cell < cells; ++cell)
+        self->cellStart.data[cell + 1] += self->cellStart.data[cell];
+
+    InputIndices_Resize(&self->cellTargets, self->cellStart.data[cells]);
+
+    // Fills each cell using its start as a cursor, which leaves every start on the next cell
+    for (size_t i = 0; i < self->targets.size; ++i)
+        if (CellRange(Box_Rect(self->targets.data[i].box), &col0, &row0, &col1, &row1))
+            for (int row = row0; row <= row1; ++row)
+                for (int col = col0; col <= col1; ++col)
+                    self->cellTargets.data[self->cellStart.data[row * self->columns + col]++] = i;
+
+    for (int cell = cells; cell > 0; --cell)
+        self->cellStart.data[cell] = self->cellStart.data[cell - 1];
+
+    self->cellStart.data[0] = 0;
+}
+
+bool CellRange(const Rect *rect, int *col0, int *row0, int *col1, int *row1)
+{
+    *col1 = floorf((rect->x + rect->w) / CellSize);
+    *row1 = floorf((rect->y + rect->h) / CellSize);
+
+    if (*col1 < 0 || *row1 < 0)
+        return false;
+
+    *col0 = fmaxf(floorf(rect->x / CellSize), 0.f);
+    *row0 = fmaxf(floorf(rect->y / CellSize), 0.f);
+
+    return true;
+}
+
+int HitTest(InputRouter * const self, int x, int y)
+{
+    if (self->dirty)
+        Rebuild(self);
+
+    const int col = floorf(x / CellSize);
+    const int row = floorf(y / CellSize);
+
+    if (col < 0 || row < 0 || col >= self->columns || row >= self->rows)
+        return -1;
+
+    const int cell = row * self->columns + col;
+
+    // Topmost first
+    for (int i = self->cellStart.data[cell + 1] - 1; i >= self->cellStart.data[cell]; --i)
+        if (Contains(self, self->cellTargets.data[i], x, y))
+            return self->cellTargets.data[i];
+
+    return -1;
+}
+
+bool Contains(InputRouter * const self, int index, int x, int y)
+{
+    const Rect *rect = Box_Rect(self->targets.data[index].box);
+
+    return x >= rect->x
+            && x <= (rect->x + rect->w)
+            && y >= rect->y
+            && y <= (rect->y + rect->h);
+}
+
+void PointerMoved(InputRouter * const self, int x, int y, const SDL_Event *event)
+{
+    // While captured, no other target sees the pointer
+    if (self->captured >= 0)
+        SetHovered(self, Contains(self, self->captured, x, y) ? self->captured : -1, event);
+    else
+        SetHovered(self, HitTest(self, x, y), event);
+}
+
+void SetHovered(InputRouter * const self, int index, const SDL_Event *event)
+{
+    const int previous = self->hovered;
+
+    if (index == previous)
+        return;
+
+    self->hovered = index;
+
+    if (previous >= 0)
+        Send(self, previous, InputRouter_PointerLeave, event);
+
+    if (index >= 0 && self->hovered == index)
+        Send(self, index, InputRouter_PointerEnter, event);
+}
+
+void Send(InputRouter * const self, int index, InputRouter_Pointer pointer, const SDL_Event *event)
+{
+    // Copied out, the handler may add or remove targets
+    const InputTarget target = self->targets.data[index];
+
+    target.handler(target.userdata, pointer, event);
+}
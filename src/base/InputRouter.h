@@ -0,0 +1,67 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef union SDL_Event SDL_Event;
+
+typedef struct Box Box;
+typedef struct InputRouter InputRouter;
+
+// Routes pointer events only to the topmost target under the cursor, found through a coarse grid
+// of the target boxes. A target pressed with the left button captures the pointer until release
+
+typedef enum InputRouter_Pointer
+{
+    InputRouter_PointerEnter,
+    InputRouter_PointerLeave,
+    InputRouter_PointerDown,
+    InputRouter_PointerUp
+} InputRouter_Pointer;
+
+typedef void (*InputRouter_PointerHandler)(void *userdata, InputRouter_Pointer pointer, const SDL_Event *event);
+
+InputRouter *InputRouter_New();
+void InputRouter_Delete(InputRouter * const self);
+
+// Targets added later are on top. Userdata identifies the target
+void InputRouter_AddTarget(InputRouter * const self, Box *box, InputRouter_PointerHandler handler, void *userdata);
+void InputRouter_RemoveTarget(InputRouter * const self, void *userdata);
+void InputRouter_Clear(InputRouter * const self);
+
+// Call after a target box, or one of its parents, moves or resizes
+void InputRouter_Invalidate(InputRouter * const self);
+
+// Returns true for pointer events, which are handled here
+bool InputRouter_ProcessEvent(InputRouter * const self, const SDL_Event *event);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,122 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Intrusive doubly linked list: the link is a member of the element itself, so nothing is allocated
+// and removing an element is O(1). The elements usually come from a Pool
+//
+//   typedef struct Sprite { IntrusiveListLink link; ... } Sprite;
+//
+//   for (IntrusiveListLink *it = IntrusiveList_GetFirst(&list); it; it = IntrusiveList_GetNext(&list, it))
+//   {
+//       Sprite *sprite = INTRUSIVE_LIST_ENTRY(it, Sprite, link);
+//   }
+
+typedef struct IntrusiveListLink
+{
+    struct IntrusiveListLink *prev;
+    struct IntrusiveListLink *next;
+} IntrusiveListLink;
+
+typedef struct IntrusiveList
+{
+    IntrusiveListLink head;
+    size_t size;
+} IntrusiveList;
+
+#define INTRUSIVE_LIST_ENTRY(LINK, TYPE, MEMBER) ((TYPE *) ((char *) (LINK) - offsetof(TYPE, MEMBER)))
+
+static inline void IntrusiveList_Init(IntrusiveList * const self)
+{
+    self->head.prev = &self->head;
+    self->head.next = &self->head;
+    self->size = 0;
+}
+
+static inline bool IntrusiveList_IsEmpty(const IntrusiveList * const self)
+{
+    return self->size == 0;
+}
+
+static inline IntrusiveListLink *IntrusiveList_GetFirst(IntrusiveList * const self)
+{
+    return self->head.next != &self->head ? self->head.next : NULL;
+}
+
+static inline IntrusiveListLink *IntrusiveList_GetLast(IntrusiveList * const self)
+{
+    return self->head.prev != &self->head ? self->head.prev : NULL;
+}
+
+static inline IntrusiveListLink *IntrusiveList_GetNext(IntrusiveList * const self, IntrusiveListLink *link)
+{
+    return link->next != &self->head ? link->next : NULL;
+}
+
+static inline IntrusiveListLink *IntrusiveList_GetPrev(IntrusiveList * const self, IntrusiveListLink *link)
+{
+    return link->prev != &self->head ? link->prev : NULL;
+}
+
+static inline void IntrusiveList_InsertBefore(IntrusiveList * const self, IntrusiveListLink *position, IntrusiveListLink *link)
+{
+    link->prev = position->prev;
+    link->next = position;
+    position->prev->next = link;
+    position->prev = link;
+
+    ++self->size;
+}
+
+static inline void IntrusiveList_PushBack(IntrusiveList * const self, IntrusiveListLink *link)
+{
+    IntrusiveList_InsertBefore(self, &self->head, link);
+}
+
+static inline void IntrusiveList_PushFront(IntrusiveList * const self, IntrusiveListLink *link)
+{
+    IntrusiveList_InsertBefore(self, self->head.next, link);
+}
+
+static inline void IntrusiveList_Remove(IntrusiveList * const self, IntrusiveListLink *link)
+{
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->prev = NULL;
+    link->next = NULL;
+
+    --self->size;
+}
+
+#ifdef __cplusplus
+}
+#endif
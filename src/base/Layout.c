@@ -0,0 +1,483 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#include "Layout.h"
+#include "Box.h"
+#include "IntrusiveList.h"
+
+#include <malloc.h>
+#include <math.h>
+#include <float.h>
+
+typedef struct Layout_Edges
+{
+    float top, right, bottom, left;
+} Layout_Edges;
+
+struct Layout
+{
+    Layout_Direction direction;
+    Layout_Align justify;
+    Layout_Align align;
+    Layout_Edges padding;
+    Layout_Edges margin;
+    float gap;
+    float grow;
+    float minW, minH;
+    float maxW, maxH;
+
+    Box *box;
+    Box *content;
+
+    Layout *parent;
+    IntrusiveList children;
+    IntrusiveListLink sibling;
+
+    // Natural size, valid while sizeDirty is false
+    float measuredW, measuredH;
+    bool sizeDirty;
+
+    // The children must be placed again. A dirty node without a fixed size always has a dirty parent
+    bool dirty;
+    bool descendantDirty;
+};
+
+#define LAYOUT_FOREACH_CHILD(SELF, CHILD) \
+    for (IntrusiveListLink *it_ = IntrusiveList_GetFirst(&(SELF)->children); it_; it_ = IntrusiveList_GetNext(&(SELF)->children, it_)) \
+        for (Layout *CHILD = INTRUSIVE_LIST_ENTRY(it_, Layout, sibling); CHILD; CHILD = NULL)
+
+void Layout_InvalidateSize(Layout * const self);
+bool Layout_IsFixedSize(Layout * const self);
+float Layout_Clamp(float value, float min, float max);
+void Layout_Measure(Layout * const self);
+void Layout_Place(Layout * const self, float x, float y, float w, float h);
+void Layout_Arrange(Layout * const self);
+void Layout_ArrangeLine(Layout * const self, bool row);
+void Layout_ArrangeStack(Layout * const self);
+float Layout_CrossOffset(Layout_Align align, float space, float size, float marginStart);
+void Layout_UpdateChildren(Layout * const self);
+
+Layout *Layout_New(Layout_Direction direction)
+{
+    Layout * const self = malloc(sizeof (Layout));
+
+    self->direction = direction;
+    self->justify = Layout_Start;
+    self->align = Layout_Start;
+    self->padding = (Layout_Edges) {0.f, 0.f, 0.f, 0.f};
+    self->margin = (Layout_Edges) {0.f, 0.f, 0.f, 0.f};
+    self->gap = 0.f;
+    self->grow = 0.f;
+    self->minW = self->minH = 0.f;
+    self->maxW = self->maxH = FLT_MAX;
+
+    // The first Layout_Place always resizes it
+    self->box = Box_New(0.f, 0.f, -1.f, -1.f);
+    self->content = NULL;
+
+    self->parent = NULL;
+    IntrusiveList_Init(&self->children);
+
+    self->measuredW = self->measuredH = 0.f;
+    self->sizeDirty = true;
+    self->dirty = true;
+    self->descendantDirty = false;
+
+    return self;
+}
+
+void Layout_Delete(Layout * const self)
+{
+    if (!self)
+        return;
+
+    while (!IntrusiveList_IsEmpty(&self->children))
+        Layout_Delete(INTRUSIVE_LIST_ENTRY(IntrusiveList_GetFirst(&self->children), Layout, sibling));
+
+    if (self->parent)
+    {
+        IntrusiveList_Remove(&self->parent->children, &self->sibling);
+        Layout_Invalidate(self->parent);
+    }
+
+    Box_Delete(self->box);
+    free(self);
+}
+
+void Layout_AddChild(Layout * const self, Layout *child)
+{
+    child->parent = self;
+    IntrusiveList_PushBack(&self->children, &child->sibling);
+    Box_SetParent(child->box, self->box);
+
+    Layout_Invalidate(child);
+}
+
+Box *Layout_Box(Layout * const self)
+{
+    return self->box;
+}
+
+void Layout_SetContent(Layout * const self, Box *content)
+{
+    self->content = content;
+
+    if (content)
+    {
+        Box_SetParent(content, self->box);
+        Box_SetPosition(content, 0.f, 0.f);
+    }
+
+    Layout_Invalidate(self);
+}
+
+void Layout_SetPosition(Layout * const self, float x, float y)
+{
+    Box_SetPosition(self->box, x, y);
+}
+
+void Layout_SetSize(Layout * const self, float w, float h)
+{
+    self->minW = w < 0.f ? 0.f : w;
+    self->maxW = w < 0.f ? FLT_MAX : w;
+    self->minH = h < 0.f ? 0.f : h;
+    self->maxH = h < 0.f ? FLT_MAX : h;
+
+    Layout_InvalidateSize(self);
+}
+
+void Layout_SetMinSize(Layout * const self, float w, float h)
+{
+    self->minW = w;
+    self->minH = h;
+
+    Layout_InvalidateSize(self);
+}
+
+void Layout_SetMaxSize(Layout * const self, float w, float h)
+{
+    self->maxW = w;
+    self->maxH = h;
+
+    Layout_InvalidateSize(self);
+}
+
+void Layout_SetPadding(Layout * const self, float top, float right, float bottom, float left)
+{
+    self->padding = (Layout_Edges) {top, right, bottom, left};
+
+    Layout_Invalidate(self);
+}
+
+void Layout_SetMargin(Layout * const self, float top, float right, float bottom, float left)
+{
+    self->margin = (Layout_Edges) {top, right, bottom, left};
+
+    // The margin belongs to the space of the parent
+    Layout_Invalidate(self->parent ? self->parent : self);
+}
+
+void Layout_SetGap(Layout * const self, float gap)
+{
+    self->gap = gap;
+
+    Layout_Invalidate(self);
+}
+
+void Layout_SetGrow(Layout * const self, float grow)
+{
+    self->grow = grow;
+
+    Layout_Invalidate(self->parent ? self->parent : self);
+}
+
+void Layout_SetJustify(Layout * const self, Layout_Align justify)
+{
+    self->justify = justify;
+
+    Layout_Invalidate(self);
+}
+
+void Layout_SetAlign(Layout * const self, Layout_Align align)
+{
+    self->align = align;
+
+    Layout_Invalidate(self);
+}
+
+void Layout_Invalidate(Layout * const self)
+{
+    Layout *node = self;
+
+    node->sizeDirty = true;
+    node->dirty = true;
+
+    // While the size can change, the parent has to place its children again
+    while (node->parent && !Layout_IsFixedSize(node))
+    {
+        node = node->parent;
+        node->sizeDirty = true;
+        node->dirty = true;
+    }
+
+    for (Layout *parent = node->parent; parent && !parent->descendantDirty; parent = parent->parent)
+        parent->descendantDirty = true;
+}
+
+void Layout_Update(Layout * const self)
+{
+    if (!self->dirty && !self->descendantDirty)
+        return;
+
+    Layout_Measure(self);
+    Layout_Place(self, Box_X(self->box), Box_Y(self->box), self->measuredW, self->measuredH);
+}
+
+void Layout_InvalidateSize(Layout * const self)
+{
+    // Even a fixed size node has to be placed again by its parent
+    self->sizeDirty = true;
+    self->dirty = true;
+
+    Layout_Invalidate(self->parent ? self->parent : self);
+}
+
+bool Layout_IsFixedSize(Layout * const self)
+{
+    return self->minW == self->maxW && self->minH == self->maxH;
+}
+
+float Layout_Clamp(float value, float min, float max)
+{
+    return fminf(fmaxf(value, min), max);
+}
+
+void Layout_Measure(Layout * const self)
+{
+    if (!self->sizeDirty)
+        return;
+
+    float w = 0.f, h = 0.f;
+    int count = 0;
+
+    LAYOUT_FOREACH_CHILD(self, child)
+    {
+        Layout_Measure(child);
+
+        const float childW = child->measuredW + child->margin.left + child->margin.right;
+        const float childH = child->measuredH + child->margin.top + child->margin.bottom;
+
+        if (self->direction == Layout_Row)
+        {
+            w += childW;
+            h = fmaxf(h, childH);
+        }
+        else if (self->direction == Layout_Column)
+        {
+            w = fmaxf(w, childW);
+            h += childH;
+        }
+        else
+        {
+            w = fmaxf(w, childW);
+            h = fmaxf(h, childH);
+        }
+
+        ++count;
+    }
+
+    if (count > 1 && self->direction == Layout_Row)
+        w += self->gap * (count - 1);
+
+    else if (count > 1 && self->direction == Layout_Column)
+        h += self->gap * (count - 1);
+
+    w += self->padding.left + self->padding.right;
+    h += self->padding.top + self->padding.bottom;
+
+    // The content is drawn behind the children, from the origin of the node
+    if (self->content)
+    {
+        w = fmaxf(w, Box_Width(self->content));
+        h = fmaxf(h, Box_Height(self->content));
+    }
+
+    self->measuredW = Layout_Clamp(w, self->minW, self->maxW);
+    self->measuredH = Layout_Clamp(h, self->minH, self->maxH);
+    self->sizeDirty = false;
+}
+
+void Layout_Place(Layout * const self, float x, float y, float w, float h)
+{
+    Box * const box = self->box;
+
+    if (Box_X(box) != x || Box_Y(box) != y)
+        Box_SetPosition(box, x, y);
+
+    if (Box_Width(box) != w || Box_Height(box) != h)
+    {
+        Box_SetSize(box, w, h);
+        self->dirty = true;
+    }
+
+    if (self->dirty)
+        Layout_Arrange(self);
+
+    else if (self->descendantDirty)
+        Layout_UpdateChildren(self);
+}
+
+void Layout_Arrange(Layout * const self)
+{
+    if (self->direction == Layout_Stack)
+        Layout_ArrangeStack(self);
+    else
+        Layout_ArrangeLine(self, self->direction == Layout_Row);
+
+    self->dirty = false;
+    self->descendantDirty = false;
+}
+
+void Layout_ArrangeLine(Layout * const self, bool row)
+{
+    const float innerW = Box_Width(self->box) - self->padding.left - self->padding.right;
+    const float innerH = Box_Height(self->box) - self->padding.top - self->padding.bottom;
+    const float mainSpace = row ? innerW : innerH;
+    const float crossSpace = row ? innerH : innerW;
+
+    float used = 0.f, totalGrow = 0.f;
+    int count = 0;
+
+    LAYOUT_FOREACH_CHILD(self, child)
+    {
+        Layout_Measure(child);
+
+        used += row ? child->measuredW + child->margin.left + child->margin.right
+                    : child->measuredH + child->margin.top + child->margin.bottom;
+        totalGrow += child->grow;
+        ++count;
+    }
+
+    if (count == 0)
+        return;
+
+    used += self->gap * (count - 1);
+
+    float freeSpace = fmaxf(mainSpace - used, 0.f);
+    float position = row ? self->padding.left : self->padding.top;
+    float spacing = self->gap;
+
+    // With growing children the free space goes to them instead
+    if (totalGrow <= 0.f)
+    {
+        if (self->justify == Layout_Center)
+            position += floorf(freeSpace / 2.f);
+        else if (self->justify == Layout_End)
+            position += freeSpace;
+        else if (self->justify == Layout_SpaceBetween && count > 1)
+            spacing += floorf(freeSpace / (count - 1));
+    }
+
+    LAYOUT_FOREACH_CHILD(self, child)
+    {
+        float mainSize = row ? child->measuredW : child->measuredH;
+        float crossSize = row ? child->measuredH : child->measuredW;
+        const float marginStart = row ? child->margin.left : child->margin.top;
+        const float marginEnd = row ? child->margin.right : child->margin.bottom;
+        const float crossStart = row ? child->margin.top : child->margin.left;
+        const float crossEnd = row ? child->margin.bottom : child->margin.right;
+
+        if (totalGrow > 0.f && child->grow > 0.f)
+            mainSize = Layout_Clamp(mainSize + floorf(freeSpace * child->grow / totalGrow),
+                                    row ? child->minW : child->minH, row ? child->maxW : child->maxH);
+
+        if (self->align == Layout_Stretch)
+            crossSize = Layout_Clamp(crossSpace - crossStart - crossEnd,
+                                     row ? child->minH : child->minW, row ? child->maxH : child->maxW);
+
+        const float crossPosition = (row ? self->padding.top : self->padding.left)
+                                  + Layout_CrossOffset(self->align, crossSpace, crossSize + crossStart + crossEnd, crossStart);
+
+        position += marginStart;
+
+        if (row)
+            Layout_Place(child, position, crossPosition, mainSize, crossSize);
+        else
+            Layout_Place(child, crossPosition, position, crossSize, mainSize);
+
+        position += mainSize + marginEnd + spacing;
+    }
+}
+
+void Layout_ArrangeStack(Layout * const self)
+{
+    const float innerW = Box_Width(self->box) - self->padding.left - self->padding.right;
+    const float innerH = Box_Height(self->box) - self->padding.top - self->padding.bottom;
+
+    LAYOUT_FOREACH_CHILD(self, child)
+    {
+        Layout_Measure(child);
+
+        float w = child->measuredW;
+        float h = child->measuredH;
+
+        if (self->align == Layout_Stretch)
+            w = Layout_Clamp(innerW - child->margin.left - child->margin.right, child->minW, child->maxW);
+
+        if (self->justify == Layout_Stretch)
+            h = Layout_Clamp(innerH - child->margin.top - child->margin.bottom, child->minH, child->maxH);
+
+        const float x = self->padding.left + Layout_CrossOffset(self->align, innerW, w + child->margin.left + child->margin.right, child->margin.left);
+        const float y = self->padding.top + Layout_CrossOffset(self->justify, innerH, h + child->margin.top + child->margin.bottom, child->margin.top);
+
+        Layout_Place(child, x, y, w, h);
+    }
+}
+
+float Layout_CrossOffset(Layout_Align align, float space, float size, float marginStart)
+{
+    // Whole pixels, so text is never sampled between texels
+    if (align == Layout_Center)
+        return floorf((space - size) / 2.f) + marginStart;
+
+    if (align == Layout_End)
+        return space - size + marginStart;
+
+    return marginStart;
+}
+
+void Layout_UpdateChildren(Layout * const self)
+{
+    // Only fixed size children can be dirty here, so their rect is still valid
+    LAYOUT_FOREACH_CHILD(self, child)
+    {
+        if (child->dirty)
+            Layout_Arrange(child);
+
+        else if (child->descendantDirty)
+            Layout_UpdateChildren(child);
+    }
+
+    self->descendantDirty = false;
+}
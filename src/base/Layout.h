@@ -0,0 +1,97 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct Box Box;
+typedef struct Layout Layout;
+
+// Flexbox style layout. Every node owns a box parented to the box of its parent node, so the
+// positions written by the layout are local and a whole subtree moves with its root. A node is at
+// least as big as its content box, which is placed at the origin of the node and never resized.
+//
+// Measured sizes and positions are cached: Layout_Invalidate marks a node and its ancestors up to the
+// first one with a fixed size, and Layout_Update lays out only those subtrees
+
+typedef enum Layout_Direction
+{
+    Layout_Row,
+    Layout_Column,
+
+    // Children are placed on top of each other: the X axis uses the align and the Y axis the justify
+    Layout_Stack
+} Layout_Direction;
+
+typedef enum Layout_Align
+{
+    Layout_Start,
+    Layout_Center,
+    Layout_End,
+
+    // Cross axis and stacks only, the children fill the node within their max size
+    Layout_Stretch,
+
+    // Main axis only, the free space goes between the children
+    Layout_SpaceBetween
+} Layout_Align;
+
+Layout *Layout_New(Layout_Direction direction);
+
+// Deletes the children too. Content boxes are not owned and become roots
+void Layout_Delete(Layout * const self);
+
+void Layout_AddChild(Layout * const self, Layout *child);
+Box *Layout_Box(Layout * const self);
+void Layout_SetContent(Layout * const self, Box *content);
+
+// Position of a root node, in the space of the parent of its box
+void Layout_SetPosition(Layout * const self, float x, float y);
+
+// A negative value keeps the axis sized by the content
+void Layout_SetSize(Layout * const self, float w, float h);
+void Layout_SetMinSize(Layout * const self, float w, float h);
+void Layout_SetMaxSize(Layout * const self, float w, float h);
+
+void Layout_SetPadding(Layout * const self, float top, float right, float bottom, float left);
+void Layout_SetMargin(Layout * const self, float top, float right, float bottom, float left);
+void Layout_SetGap(Layout * const self, float gap);
+void Layout_SetGrow(Layout * const self, float grow);
+void Layout_SetJustify(Layout * const self, Layout_Align justify);
+void Layout_SetAlign(Layout * const self, Layout_Align align);
+
+// Must be called after the size of a content box changed
+void Layout_Invalidate(Layout * const self);
+
+// Called on the root, does nothing if no node was invalidated
+void Layout_Update(Layout * const self);
+
+#ifdef __cplusplus
+}
+#endif
@@ -23,6 +23,7 @@ SOFTWARE.
 -------------------------------------------------------------------------------*/
 
 #include "LinkedList.h"
+#include "Pool.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -45,8 +46,11 @@ struct LinkedList
     LinkedListNode *firstNode;
     LinkedListNode *lastNode;
     size_t size;
+    Pool *nodes;
 };
 
+static const size_t NodesPerBlock = 32;
+
 LinkedList *LinkedList_New()
 {
     LinkedList * const self = malloc(sizeof (LinkedList));
@@ -54,6 +58,7 @@ LinkedList *LinkedList_New()
     self->firstNode = NULL;
     self->lastNode = NULL;
     self->size = 0;
+    self->nodes = Pool_New(sizeof (LinkedListNode), NodesPerBlock);
 
     return self;
 }
@@ -63,7 +68,7 @@ void LinkedList_Delete(LinkedList * const self)
     if (!self)
         return;
 
-    LinkedList_Clear(self);
+    Pool_Delete(self->nodes);
 
     free(self);
 }
@@ -110,23 +115,16 @@ LinkedListNode *LinkedList_GetNext(LinkedList * const self, LinkedListNode *node
 
 void LinkedList_Clear(LinkedList * const self)
 {
-    LinkedListNode *current = self->firstNode;
-
-    while (current)
-    {
-        LinkedListNode *next = current->next;
-        free(current);
-        current = next;
-    }
+    Pool_Clear(self->nodes);
 
     self->firstNode = NULL;
     self->lastNode = NULL;
     self->size = 0;
 }
 
-static LinkedListNode *push_next(LinkedListNode *prev)
+static LinkedListNode *push_next(LinkedList *self, LinkedListNode *prev)
 {
-    LinkedListNode *node = malloc(sizeof (LinkedListNode));
+    LinkedListNode *node = Pool_Alloc(self->nodes);
 
     node->prev = prev;
     node->next = NULL;
@@ -139,11 +137,11 @@ static LinkedListNode *push(LinkedList *self)
     self->size++;
 
     if (self->firstNode == NULL)
-        return self->firstNode = self->lastNode = push_next(NULL);
+        return self->firstNode = self->lastNode = push_next(self, NULL);
 
     LinkedListNode *last = LinkedList_GetLast(self);
 
-    return self->lastNode = last->next = push_next(last);
+    return self->lastNode = last->next = push_next(self, last);
 }
 
 void LinkedList_PushPtr(LinkedList *self, void *value)
@@ -192,7 +190,7 @@ void LinkedList_Remove(LinkedList * const self, LinkedListNode **node)
     if (self->lastNode == current)
         self->lastNode = prev;
 
-    free(current);
+    Pool_Free(self->nodes, current);
 
     *node = next;
 
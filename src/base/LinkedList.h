@@ -30,7 +30,8 @@ SOFTWARE.
 extern "C" {
 #endif
 
-// Doubly linked list
+// Doubly linked list of values, the nodes come from a Pool owned by the list.
+// IntrusiveList links elements without any node, Vector keeps them contiguous
 
 typedef struct LinkedList LinkedList;
 typedef struct LinkedListNode LinkedListNode;
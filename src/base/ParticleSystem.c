@@ -0,0 +1,242 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#include "ParticleSystem.h"
+#include "opengl_renderer/OpenGLRenderer.h"
+#include "rect.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <cglm/util.h>
+
+static const uint32_t DefaultSeed = 0x9E3779B9u;
+
+struct ParticleSystem
+{
+    OpenGLRenderer *renderer;
+
+    int count;
+    int capacity;
+    float *x;
+    float *y;
+    float *vx;
+    float *vy;
+    float *age; // 0 when emitted, 1 at the end of the lifetime
+    float *ageRate; // inverse of the lifetime
+    float *size;
+    uint8_t (*colors)[4];
+
+    // Filled from the arrays above on each draw
+    ParticleVertex *vertices;
+
+    float gravityX;
+    float gravityY;
+    uint32_t seed;
+};
+
+static void Simulate(int count, float step, float gravityX, float gravityY, float * restrict x, float * restrict y,
+                     float * restrict vx, float * restrict vy, float * restrict age, const float * restrict ageRate);
+static void Remove(ParticleSystem * const self, int index);
+static float Random(ParticleSystem * const self, float min, float max);
+
+ParticleSystem *ParticleSystem_New(OpenGLRenderer *renderer, int capacity)
+{
+    ParticleSystem * const self = malloc(sizeof (ParticleSystem));
+
+    self->renderer = renderer;
+    self->count = 0;
+    self->capacity = capacity;
+    self->x = malloc(sizeof (float) * capacity);
+    self->y = malloc(sizeof (float) * capacity);
+    self->vx = malloc(sizeof (float) * capacity);
+    self->vy = malloc(sizeof (float) * capacity);
+    self->age = malloc(sizeof (float) * capacity);
+    self->ageRate = malloc(sizeof (float) * capacity);
+    self->size = malloc(sizeof (float) * capacity);
+    self->colors = malloc(sizeof (uint8_t[4]) * capacity);
+    self->vertices = malloc(sizeof (ParticleVertex) * capacity);
+    self->gravityX = 0.0f;
+    self->gravityY = 0.0f;
+    self->seed = DefaultSeed;
+
+    return self;
+}
+
+void ParticleSystem_Delete(ParticleSystem * const self)
+{
+    if (!self)
+        return;
+
+    free(self->x);
+    free(self->y);
+    free(self->vx);
+    free(self->vy);
+    free(self->age);
+    free(self->ageRate);
+    free(self->size);
+    free(self->colors);
+    free(self->vertices);
+    free(self);
+}
+
+int ParticleSystem_Burst(ParticleSystem * const self, const ParticleBurst *burst)
+{
+    const int available = self->capacity - self->count;
+    const int count = burst->count < available ? burst->count : available;
+
+    for (int n = 0; n < count; ++n)
+    {
+        const int i = self->count++;
+        const float angle = glm_rad(burst->direction + Random(self, -0.5f, 0.5f) * burst->spread);
+        const float speed = Random(self, burst->minSpeed, burst->maxSpeed);
+
+        self->x[i] = burst->x;
+        self->y[i] = burst->y;
+        self->vx[i] = cosf(angle) * speed;
+        self->vy[i] = sinf(angle) * speed;
+        self->age[i] = 0.0f;
+        self->ageRate[i] = 1.0f / Random(self, burst->minLifetime, burst->maxLifetime);
+        self->size[i] = Random(self, burst->minSize, burst->maxSize);
+
+        const Color color = burst->colorsCount > 0
+                ? burst->colors[(int) Random(self, 0.0f, burst->colorsCount) % burst->colorsCount]
+                : (Color) {255, 255, 255, 255};
+
+        self->colors[i][0] = color.r;
+        self->colors[i][1] = color.g;
+        self->colors[i][2] = color.b;
+        self->colors[i][3] = color.a;
+    }
+
+    return count;
+}
+
+void ParticleSystem_SetGravity(ParticleSystem * const self, float x, float y)
+{
+    self->gravityX = x;
+    self->gravityY = y;
+}
+
+void ParticleSystem_SetSeed(ParticleSystem * const self, uint32_t seed)
+{
+    // Xorshift never leaves 0
+    self->seed = seed ? seed : DefaultSeed;
+}
+
+void ParticleSystem_Clear(ParticleSystem * const self)
+{
+    self->count = 0;
+}
+
+void ParticleSystem_Update(ParticleSystem * const self, double deltaTime)
+{
+    if (self->count == 0)
+        return;
+
+    Simulate(self->count, deltaTime, self->gravityX, self->gravityY, self->x, self->y, self->vx, self->vy, self->age, self->ageRate);
+
+    for (int i = 0; i < self->count;)
+    {
+        if (self->age[i] >= 1.0f)
+            Remove(self, i);
+        else
+            ++i;
+    }
+}
+
+void ParticleSystem_Draw(ParticleSystem * const self)
+{
+    if (self->count == 0)
+        return;
+
+    // Particles fade out and shrink to half their size over their lifetime
+    for (int i = 0; i < self->count; ++i)
+    {
+        const float life = 1.0f - self->age[i];
+        ParticleVertex * const vertex = &self->vertices[i];
+
+        vertex->position[0] = self->x[i];
+        vertex->position[1] = self->y[i];
+        vertex->size = self->size[i] * (0.5f + 0.5f * life);
+        vertex->color[0] = self->colors[i][0];
+        vertex->color[1] = self->colors[i][1];
+        vertex->color[2] = self->colors[i][2];
+        vertex->color[3] = self->colors[i][3] * life;
+    }
+
+    OpenGLRenderer_DrawParticles(self->renderer, self->vertices, self->count);
+}
+
+int ParticleSystem_Count(ParticleSystem * const self)
+{
+    return self->count;
+}
+
+// Kept apart with restrict arrays, so the compiler vectorizes it
+void Simulate(int count, float step, float gravityX, float gravityY, float * restrict x, float * restrict y,
+              float * restrict vx, float * restrict vy, float * restrict age, const float * restrict ageRate)
+{
+    const float gravityStepX = gravityX * step;
+    const float gravityStepY = gravityY * step;
+
+    for (int i = 0; i < count; ++i)
+    {
+        vx[i] += gravityStepX;
+        vy[i] += gravityStepY;
+        x[i] += vx[i] * step;
+        y[i] += vy[i] * step;
+        age[i] += ageRate[i] * step;
+    }
+}
+
+void Remove(ParticleSystem * const self, int index)
+{
+    const int last = --self->count;
+
+    self->x[index] = self->x[last];
+    self->y[index] = self->y[last];
+    self->vx[index] = self->vx[last];
+    self->vy[index] = self->vy[last];
+    self->age[index] = self->age[last];
+    self->ageRate[index] = self->ageRate[last];
+    self->size[index] = self->size[last];
+    self->colors[index][0] = self->colors[last][0];
+    self->colors[index][1] = self->colors[last][1];
+    self->colors[index][2] = self->colors[last][2];
+    self->colors[index][3] = self->colors[last][3];
+}
+
+float Random(ParticleSystem * const self, float min, float max)
+{
+    uint32_t x = self->seed;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    self->seed = x;
+
+    // The top 24 bits, exact in a float, give [0, 1)
+    return min + (max - min) * ((x >> 8) * (1.0f / 16777216.0f));
+}
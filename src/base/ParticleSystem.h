@@ -0,0 +1,70 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Short lived particles, simulated on the CPU and drawn by the renderer in a single call. The pool is allocated
+// once at its capacity and kept as a structure of arrays without holes, dead particles are swapped with the last
+// live one so the arrays stay packed
+
+typedef struct Color Color;
+typedef struct OpenGLRenderer OpenGLRenderer;
+
+typedef struct ParticleBurst
+{
+    float x, y; // logical coordinates
+    int count;
+    float minSpeed, maxSpeed; // logical pixels per second
+    float direction, spread; // degrees, 0 points right and 90 down, a spread of 360 goes every way
+    float minLifetime, maxLifetime; // seconds
+    float minSize, maxSize; // logical pixels
+    const Color *colors; // picked at random for each particle, NULL is white
+    int colorsCount;
+} ParticleBurst;
+
+typedef struct ParticleSystem ParticleSystem;
+
+ParticleSystem *ParticleSystem_New(OpenGLRenderer *renderer, int capacity);
+void ParticleSystem_Delete(ParticleSystem * const self);
+
+// Emits up to burst->count particles, less once the pool is full. Returns how many were emitted
+int ParticleSystem_Burst(ParticleSystem * const self, const ParticleBurst *burst);
+// Acceleration of every particle, in logical pixels per second squared
+void ParticleSystem_SetGravity(ParticleSystem * const self, float x, float y);
+// The random sequence of the bursts, fixed by default so replays emit the same particles
+void ParticleSystem_SetSeed(ParticleSystem * const self, uint32_t seed);
+void ParticleSystem_Clear(ParticleSystem * const self);
+void ParticleSystem_Update(ParticleSystem * const self, double deltaTime);
+void ParticleSystem_Draw(ParticleSystem * const self);
+int ParticleSystem_Count(ParticleSystem * const self);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,138 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#include "Pool.h"
+
+#include <stdalign.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct FreeElement
+{
+    struct FreeElement *next;
+} FreeElement;
+
+typedef struct Block
+{
+    struct Block *next;
+    alignas(max_align_t) unsigned char elements[];
+} Block;
+
+struct Pool
+{
+    size_t elementSize;
+    size_t elementsPerBlock;
+    Block *blocks;
+    FreeElement *firstFree;
+};
+
+static void AddBlock(Pool * const self);
+static void FreeBlockElements(Pool * const self, Block *block);
+
+Pool *Pool_New(size_t elementSize, size_t elementsPerBlock)
+{
+    Pool * const self = malloc(sizeof (Pool));
+
+    // Every element can hold the free list link and keeps the alignment of malloc
+    const size_t alignment = alignof(max_align_t);
+
+    if (elementSize < sizeof (FreeElement))
+        elementSize = sizeof (FreeElement);
+
+    self->elementSize = (elementSize + alignment - 1) / alignment * alignment;
+    self->elementsPerBlock = elementsPerBlock ? elementsPerBlock : 1;
+    self->blocks = NULL;
+    self->firstFree = NULL;
+
+    return self;
+}
+
+void Pool_Delete(Pool * const self)
+{
+    if (!self)
+        return;
+
+    while (self->blocks)
+    {
+        Block *block = self->blocks;
+        self->blocks = block->next;
+
+        free(block);
+    }
+
+    free(self);
+}
+
+void *Pool_Alloc(Pool * const self)
+{
+    if (!self->firstFree)
+        AddBlock(self);
+
+    FreeElement *element = self->firstFree;
+    self->firstFree = element->next;
+
+    return element;
+}
+
+void Pool_Free(Pool * const self, void *element)
+{
+    if (!element)
+        return;
+
+    FreeElement *freed = element;
+
+    freed->next = self->firstFree;
+    self->firstFree = freed;
+}
+
+void Pool_Clear(Pool * const self)
+{
+    self->firstFree = NULL;
+
+    for (Block *block = self->blocks; block; block = block->next)
+        FreeBlockElements(self, block);
+}
+
+void AddBlock(Pool * const self)
+{
+    Block *block = malloc(sizeof (Block) + self->elementSize * self->elementsPerBlock);
+
+    if (!block)
+    {
+        puts("Out of memory growing a pool");
+        exit(EXIT_FAILURE);
+    }
+
+    block->next = self->blocks;
+    self->blocks = block;
+
+    FreeBlockElements(self, block);
+}
+
+void FreeBlockElements(Pool * const self, Block *block)
+{
+    // Pushed in reverse, so elements are handed out in address order
+    for (size_t i = self->elementsPerBlock; i-- > 0;)
+        Pool_Free(self, block->elements + i * self->elementSize);
+}
@@ -23,17 +23,22 @@ SOFTWARE.
 -------------------------------------------------------------------------------*/
 
 #include "Rectangle.h"
+#include "Animation.h"
 #include "Box.h"
 #include "rect.h"
 #include "opengl_renderer/OpenGLRenderer.h"
 
 #include <malloc.h>
+#include <stdbool.h>
 
 struct Rectangle
 {
     OpenGLRenderer *renderer;
     Box *box;
     Color color;
+    float radius;
+    Animation animation;
+    bool animated;
 };
 
 Rectangle *Rectangle_New(OpenGLRenderer *renderer, float width, float height)
@@ -43,6 +48,8 @@ Rectangle *Rectangle_New(OpenGLRenderer *renderer, float width, float height)
     self->renderer = renderer;
     self->box = Box_New(0.f, 0.f, width, height);
     self->color = (Color) {0, 0, 0, 0};
+    self->radius = 0.f;
+    self->animated = false;
 
     return self;
 }
@@ -58,7 +65,12 @@ void Rectangle_Delete(Rectangle * const self)
 
 void Rectangle_Draw(Rectangle * const self)
 {
-    OpenGLRenderer_FillRect(self->renderer, Box_Rect(self->box), &self->color);
+    const Animation *animation = self->animated ? &self->animation : NULL;
+
+    if (self->radius > 0.f)
+        OpenGLRenderer_DrawRoundedRect(self->renderer, Box_Rect(self->box), self->radius, 0.f, &self->color, animation);
+    else
+        OpenGLRenderer_FillRectAnimated(self->renderer, Box_Rect(self->box), &self->color, animation);
 }
 
 void Rectangle_SetColor(Rectangle * const self, Color color)
@@ -87,6 +99,24 @@ Color Rectangle_Color(Rectangle * const self)
     return self->color;
 }
 
+void Rectangle_SetAnimation(Rectangle * const self, const Animation *animation)
+{
+    self->animated = animation != NULL;
+
+    if (animation)
+        self->animation = *animation;
+}
+
+void Rectangle_SetRadius(Rectangle * const self, float radius)
+{
+    self->radius = radius;
+}
+
+float Rectangle_Radius(Rectangle * const self)
+{
+    return self->radius;
+}
+
 Box *Rectangle_Box(Rectangle * const self)
 {
     return self->box;
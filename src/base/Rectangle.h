@@ -31,6 +31,7 @@ extern "C" {
 #endif
 
 typedef struct Color Color;
+typedef struct Animation Animation;
 typedef struct OpenGLRenderer OpenGLRenderer;
 typedef struct Box Box;
 
@@ -44,6 +45,11 @@ void Rectangle_SetColor(Rectangle * const self, Color color);
 void Rectangle_SetColorRGB(Rectangle * const self, uint8_t r, uint8_t g, uint8_t b);
 void Rectangle_SetColorRGBA(Rectangle * const self, uint8_t r, uint8_t g, uint8_t b, uint8_t a);
 Color Rectangle_Color(Rectangle * const self);
+// Animated on the GPU from the renderer clock, NULL stops it
+void Rectangle_SetAnimation(Rectangle * const self, const Animation *animation);
+// Rounded corners, drawn by the shape program of the renderer. 0 is a plain rect
+void Rectangle_SetRadius(Rectangle * const self, float radius);
+float Rectangle_Radius(Rectangle * const self);
 
 Box *Rectangle_Box(Rectangle * const self);
 
@@ -23,6 +23,15 @@ SOFTWARE.
 -------------------------------------------------------------------------------*/
 
 #include "SceneManager.h"
+#include "AssetLoader.h"
+#include "AssetWatcher.h"
+#include "DynamicResolution.h"
+#include "FrameStats.h"
+#include "InputRecorder.h"
+#include "InputReplay.h"
+#include "InputRouter.h"
+#include "Snapshot.h"
+#include "Tween.h"
 #include "Window.h"
 #include "Graphics.h"
 #include "opengl_renderer/OpenGLRenderer.h"
@@ -35,13 +44,24 @@ SOFTWARE.
 
 #include <SDL2/SDL.h>
 
+// Frame time spent handing finished assets to the GPU
+static const double AssetUploadBudgetMs = 4.0;
+
 struct SceneManager
 {
     SDL_Event event;
     uint64_t lastPerformanceCounter;
+
+    // Frames run so far and the scene clock, which steps by fixedDeltaTime when it's set
+    uint64_t frame;
+    double time;
+    double deltaTime;
+    double fixedDeltaTime;
+
     Window *window;
     Graphics *graphics;
     OpenGLRenderer *renderer;
+    InputRouter *inputRouter;
 
     SceneManager_CurrentScene newScene;
 
@@ -52,6 +72,20 @@ struct SceneManager
     } scene;
 
     Timer *timer;
+    Tween *tween;
+
+    InputRecorder *recorder;
+    InputReplay *replay;
+    FrameStats *frameStats;
+
+    // Headless runs end frames with a GPU finish instead of a swap, and can stop after a number of frames
+    bool headless;
+    uint64_t frameLimit;
+    const char *snapshotDirectory;
+    uint64_t snapshotInterval;
+
+    // Adapts the render scale to the GPU time of the frames, NULL when it's off
+    DynamicResolution *dynamicResolution;
 };
 
 static void OverrideSceneFunctions(SceneManager_CurrentScene *func)
@@ -66,8 +100,17 @@ static void OverrideSceneFunctions(SceneManager_CurrentScene *func)
 }
 
 void SceneManager_InitScene(SceneManager * const self);
+void SceneManager_AdvanceClock(SceneManager * const self);
+bool SceneManager_PollEvents(SceneManager * const self);
 void SceneManager_Update(SceneManager * const self);
 void SceneManager_Draw(SceneManager * const self);
+void SceneManager_Present(SceneManager * const self);
+void SceneManager_EndPass(SceneManager * const self, FrameStats_Pass pass, Uint64 *passStart);
+void SceneManager_SaveSnapshot(SceneManager * const self);
+void SceneManager_DispatchEvent(SceneManager * const self, const SDL_Event *event);
+void SceneManager_Resize(SceneManager * const self, const SDL_Event *event);
+void SceneManager_UpdateRenderScale(SceneManager * const self);
+int SceneManager_OnEventWatch(void *userdata, SDL_Event *event);
 bool SceneManager_MainLoop(SceneManager * const self);
 
 SceneManager *SceneManager_New(Window *window, Graphics *graphics)
@@ -77,13 +120,31 @@ SceneManager *SceneManager_New(Window *window, Graphics *graphics)
     self->window = window;
     self->graphics = graphics;
     self->renderer = Graphics_GetRenderer(graphics);
+    self->inputRouter = InputRouter_New();
     self->lastPerformanceCounter = SDL_GetPerformanceCounter();
+    self->frame = 0;
+    self->time = 0.0;
+    self->deltaTime = 0.0;
+    self->fixedDeltaTime = 0.0;
 
     OverrideSceneFunctions(&self->newScene);
     OverrideSceneFunctions(&self->scene.func);
     self->scene.self = NULL;
 
     self->timer = Timer_New();
+    self->tween = Tween_New();
+    self->recorder = NULL;
+    self->replay = NULL;
+    self->frameStats = FrameStats_New();
+    self->headless = false;
+    self->frameLimit = 0;
+    self->snapshotDirectory = NULL;
+    self->snapshotInterval = 0;
+    self->dynamicResolution = NULL;
+
+#if defined(_WIN32) || defined(__MACOSX__)
+    SDL_AddEventWatch(SceneManager_OnEventWatch, self);
+#endif
 
     return self;
 }
@@ -93,11 +154,25 @@ void SceneManager_Delete(SceneManager * const self)
     if (!self)
         return;
 
+#if defined(_WIN32) || defined(__MACOSX__)
+    SDL_DelEventWatch(SceneManager_OnEventWatch, self);
+#endif
+
+    if (self->recorder)
+        InputRecorder_Finish(self->recorder, self->frame);
+
+    InputRecorder_Delete(self->recorder);
+    InputReplay_Delete(self->replay);
+    FrameStats_Delete(self->frameStats);
+    DynamicResolution_Delete(self->dynamicResolution);
     Timer_Delete(self->timer);
 
     if (self->scene.func.onDelete)
         self->scene.func.onDelete(self->scene.self);
 
+    // After the scene, which may still cancel its tweens
+    Tween_Delete(self->tween);
+    InputRouter_Delete(self->inputRouter);
     free(self);
 }
 
@@ -110,19 +185,34 @@ void SceneManager_InitScene(SceneManager * const self)
 {
     if (self->newScene.onNew)
     {
+        // The old scene owns the targets, so its tweens go first
+        Tween_Clear(self->tween);
+
         if (self->scene.func.onDelete)
             self->scene.func.onDelete(self->scene.self);
 
         self->scene.func = self->newScene;
         OverrideSceneFunctions(&self->newScene);
 
+        InputRouter_Clear(self->inputRouter);
+
         self->scene.self = self->scene.func.onNew(self);
     }
 }
 
-void SceneManager_AddTimer(SceneManager * const self, uint32_t interval, SceneManager_TimerCallback callback, void *userdata)
+SceneManager_TimerId SceneManager_AddTimer(SceneManager * const self, uint32_t interval, SceneManager_TimerCallback callback, void *userdata)
+{
+    return Timer_Add(self->timer, interval, callback, userdata);
+}
+
+SceneManager_TimerId SceneManager_AddRepeatingTimer(SceneManager * const self, uint32_t interval, SceneManager_TimerCallback callback, void *userdata)
+{
+    return Timer_AddRepeating(self->timer, interval, callback, userdata);
+}
+
+void SceneManager_CancelTimer(SceneManager * const self, SceneManager_TimerId id)
 {
-    Timer_Add(self->timer, interval, callback, userdata);
+    Timer_Cancel(self->timer, id);
 }
 
 void SceneManager_ClearTimers(SceneManager * const self)
@@ -130,27 +220,252 @@ void SceneManager_ClearTimers(SceneManager * const self)
     Timer_Clear(self->timer);
 }
 
+bool SceneManager_RecordInput(SceneManager * const self, const char *filename)
+{
+    InputRecorder_Delete(self->recorder);
+    self->recorder = InputRecorder_New(filename);
+
+    return self->recorder != NULL;
+}
+
+bool SceneManager_ReplayInput(SceneManager * const self, const char *filename)
+{
+    InputReplay_Delete(self->replay);
+    self->replay = InputReplay_New(filename);
+
+    return self->replay != NULL;
+}
+
+void SceneManager_SetFixedDeltaTime(SceneManager * const self, double deltaTime)
+{
+    self->fixedDeltaTime = deltaTime;
+}
+
+FrameStats *SceneManager_FrameStats(SceneManager * const self)
+{
+    return self->frameStats;
+}
+
+void SceneManager_SetHeadless(SceneManager * const self, bool headless)
+{
+    self->headless = headless;
+}
+
+void SceneManager_SetFrameLimit(SceneManager * const self, uint64_t frames)
+{
+    self->frameLimit = frames;
+}
+
+void SceneManager_SetSnapshots(SceneManager * const self, const char *directory, uint64_t interval)
+{
+    self->snapshotDirectory = directory;
+    self->snapshotInterval = interval;
+}
+
+bool SceneManager_SetDynamicResolution(SceneManager * const self, double budgetSeconds)
+{
+    DynamicResolution_Delete(self->dynamicResolution);
+    self->dynamicResolution = NULL;
+
+    OpenGLRenderer_SetRenderScale(self->renderer, 1.0f);
+
+    if (budgetSeconds <= 0.0)
+        return true;
+
+    // Timer queries are the only way to tell the GPU time apart from waiting on vsync
+    if (!OpenGLRenderer_IsGpuTimerSupported(self->renderer))
+    {
+        printf("Dynamic resolution needs GPU timer queries, rendering at full resolution\n");
+        return false;
+    }
+
+    self->dynamicResolution = DynamicResolution_New(budgetSeconds, 0.5f, 1.0f);
+
+    return true;
+}
+
 bool SceneManager_MainLoop(SceneManager * const self)
 {
+    const Uint64 frameStart = SDL_GetPerformanceCounter();
+    Uint64 passStart = frameStart;
+
+    SceneManager_AdvanceClock(self);
     SceneManager_InitScene(self);
 
+    if (!SceneManager_PollEvents(self))
+        return false;
+
+    SceneManager_EndPass(self, FrameStats_Events, &passStart);
+
+    Timer_Update(self->timer, self);
+    AssetWatcher_Update();
+    AssetLoader_Update(AssetUploadBudgetMs);
+    SceneManager_EndPass(self, FrameStats_TimersAndAssets, &passStart);
+
+    SceneManager_Update(self);
+    SceneManager_EndPass(self, FrameStats_Update, &passStart);
+
+    SceneManager_Draw(self);
+    SceneManager_EndPass(self, FrameStats_Draw, &passStart);
+
+    OpenGLRenderer_EndFrame(self->renderer);
+    SceneManager_EndPass(self, FrameStats_Flush, &passStart);
+
+    // Read back before the swap, which leaves the back buffer undefined. Not timed, the read
+    // stalls until the frame is drawn
+    const Uint64 snapshotStart = SDL_GetPerformanceCounter();
+    SceneManager_SaveSnapshot(self);
+    const Uint64 snapshotTime = SDL_GetPerformanceCounter() - snapshotStart;
+    passStart += snapshotTime;
+
+    SceneManager_Present(self);
+    SceneManager_EndPass(self, FrameStats_Present, &passStart);
+
+    SceneManager_UpdateRenderScale(self);
+
+    FrameStats_Add(self->frameStats, (double)(passStart - frameStart - snapshotTime) / (double)SDL_GetPerformanceFrequency());
+
+    self->frame++;
+
+    return self->frameLimit == 0 || self->frame < self->frameLimit;
+}
+
+void SceneManager_AdvanceClock(SceneManager * const self)
+{
+    Uint64 now = SDL_GetPerformanceCounter();
+    double elapsed = (double)(now - self->lastPerformanceCounter) / (double)SDL_GetPerformanceFrequency();
+    self->lastPerformanceCounter = now;
+
+    self->deltaTime = self->fixedDeltaTime > 0.0 ? self->fixedDeltaTime : elapsed;
+
+    // Replays advance by the recorded steps, so timers and animations fire on the same frames
+    if (self->replay)
+        InputReplay_FrameTime(self->replay, self->frame, &self->deltaTime);
+    else if (self->recorder)
+        self->deltaTime = InputRecorder_RecordFrame(self->recorder, self->frame, self->deltaTime);
+
+    self->time += self->deltaTime;
+
+    Timer_SetTime(self->timer, self->time * 1000.0);
+}
+
+bool SceneManager_PollEvents(SceneManager * const self)
+{
+    // Mouse motion and resizes are coalesced into one event per frame, flushed early to keep them
+    // ordered with clicks
+    SDL_Event motion, resize;
+    bool hasMotion = false, hasResize = false;
+
     while (SDL_PollEvent(&self->event))
     {
         if (self->event.type == SDL_QUIT || self->event.key.keysym.sym == SDLK_AC_BACK)
             return false;
 
-        if (self->scene.func.onProcessEvent)
-            self->scene.func.onProcessEvent(self->scene.self, &self->event);
+        // Live input would make the replay diverge
+        if (self->replay)
+            continue;
+
+        if (self->event.type == SDL_MOUSEMOTION)
+        {
+            if (hasMotion)
+            {
+                self->event.motion.xrel += motion.motion.xrel;
+                self->event.motion.yrel += motion.motion.yrel;
+            }
+
+            motion = self->event;
+            hasMotion = true;
+
+            continue;
+        }
+
+        if (self->event.type == SDL_WINDOWEVENT && self->event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+        {
+            resize = self->event;
+            hasResize = true;
+
+            continue;
+        }
+
+        if (hasResize)
+        {
+            SceneManager_DispatchEvent(self, &resize);
+            hasResize = false;
+        }
+
+        if (hasMotion)
+        {
+            SceneManager_DispatchEvent(self, &motion);
+            hasMotion = false;
+        }
+
+        SceneManager_DispatchEvent(self, &self->event);
+    }
+
+    if (hasResize)
+        SceneManager_DispatchEvent(self, &resize);
+
+    if (hasMotion)
+        SceneManager_DispatchEvent(self, &motion);
+
+    if (self->replay)
+    {
+        while (InputReplay_Next(self->replay, self->frame, &self->event))
+            SceneManager_DispatchEvent(self, &self->event);
 
-        Timer_ProcessEvent(self->timer, self, &self->event);
+        if (InputReplay_IsFinished(self->replay, self->frame))
+            return false;
     }
 
-    Timer_Update(self->timer, self);
+    return true;
+}
+
+void SceneManager_DispatchEvent(SceneManager * const self, const SDL_Event *event)
+{
+    if (self->recorder)
+        InputRecorder_Record(self->recorder, self->frame, event);
+
+    if (event->type == SDL_WINDOWEVENT && event->window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+        SceneManager_Resize(self, event);
+
+    InputRouter_ProcessEvent(self->inputRouter, event);
+
+    if (self->scene.func.onProcessEvent)
+        self->scene.func.onProcessEvent(self->scene.self, event);
+}
+
+void SceneManager_Resize(SceneManager * const self, const SDL_Event *event)
+{
+    // A replayed resize uses the recorded size, the window itself keeps the current one
+    Window_UpdateSize(self->window);
+    Graphics_Resize(self->graphics, (IVec2) {.w = event->window.data1, .h = event->window.data2}, Window_GetDrawableSize(self->window));
+
+    // The scene lays itself out again when it gets the event, the hit grid follows on the next pointer event
+    InputRouter_Invalidate(self->inputRouter);
+}
+
+int SceneManager_OnEventWatch(void *userdata, SDL_Event *event)
+{
+    SceneManager * const self = userdata;
+
+    // The event loop is blocked while the window is dragged, so frames are drawn from here meanwhile.
+    // The event is still queued and dispatched again by SceneManager_PollEvents, which is harmless
+    if (self->headless || self->replay)
+        return 0;
+
+    if (event->type != SDL_WINDOWEVENT || event->window.event != SDL_WINDOWEVENT_SIZE_CHANGED)
+        return 0;
+
+    SceneManager_Resize(self, event);
+
+    if (self->scene.func.onProcessEvent)
+        self->scene.func.onProcessEvent(self->scene.self, event);
 
-    SceneManager_Update(self);
     SceneManager_Draw(self);
+    OpenGLRenderer_EndFrame(self->renderer);
+    SceneManager_Present(self);
 
-    return true;
+    return 0;
 }
 
 #ifdef __EMSCRIPTEN__
@@ -181,22 +496,65 @@ void SceneManager_Run(SceneManager * const self)
 
 void SceneManager_Update(SceneManager * const self)
 {
-    Uint64 now = SDL_GetPerformanceCounter();
-    double deltaTime = (double)(now - self->lastPerformanceCounter) / (double)SDL_GetPerformanceFrequency();
-    self->lastPerformanceCounter = now;
+    Tween_Update(self->tween, self->deltaTime);
 
     if (self->scene.func.onUpdate)
-        self->scene.func.onUpdate(self->scene.self, deltaTime);
+        self->scene.func.onUpdate(self->scene.self, self->deltaTime);
 }
 
 void SceneManager_Draw(SceneManager * const self)
 {
+    // The scene clock, so animations follow the fixed step of replays and benchmarks
+    OpenGLRenderer_SetTime(self->renderer, self->time);
     OpenGLRenderer_Clear(self->renderer);
 
     if (self->scene.func.onDraw)
         self->scene.func.onDraw(self->scene.self);
+}
+
+void SceneManager_Present(SceneManager * const self)
+{
+    if (self->headless)
+        OpenGLRenderer_Finish(self->renderer);
+    else
+        Window_SwapWindow(self->window);
+}
+
+void SceneManager_EndPass(SceneManager * const self, FrameStats_Pass pass, Uint64 *passStart)
+{
+    const Uint64 now = SDL_GetPerformanceCounter();
+
+    FrameStats_AddPass(self->frameStats, pass, (double)(now - *passStart) / (double)SDL_GetPerformanceFrequency());
+    *passStart = now;
+}
+
+void SceneManager_UpdateRenderScale(SceneManager * const self)
+{
+    double gpuSeconds;
 
-    Window_SwapWindow(self->window);
+    if (!self->dynamicResolution || !OpenGLRenderer_GpuFrameTime(self->renderer, &gpuSeconds))
+        return;
+
+    OpenGLRenderer_SetRenderScale(self->renderer, DynamicResolution_Update(self->dynamicResolution, gpuSeconds));
+}
+
+void SceneManager_SaveSnapshot(SceneManager * const self)
+{
+    if (!self->snapshotDirectory)
+        return;
+
+    // A replay ends when the next frame polls its events, this one is the last drawn
+    const bool lastFrame = (self->frameLimit && self->frame + 1 == self->frameLimit)
+            || (self->replay && InputReplay_IsFinished(self->replay, self->frame + 1));
+    const bool interval = self->snapshotInterval && self->frame % self->snapshotInterval == 0;
+
+    if (!lastFrame && !interval)
+        return;
+
+    char filename[1024];
+    snprintf(filename, sizeof (filename), "%s/frame_%06llu.png", self->snapshotDirectory, (unsigned long long) self->frame);
+
+    Snapshot_SavePNG(self->renderer, filename);
 }
 
 Window *SceneManager_Window(SceneManager * const self)
@@ -208,3 +566,13 @@ Graphics *SceneManager_Graphics(SceneManager * const self)
 {
     return self->graphics;
 }
+
+InputRouter *SceneManager_InputRouter(SceneManager * const self)
+{
+    return self->inputRouter;
+}
+
+Tween *SceneManager_Tween(SceneManager * const self)
+{
+    return self->tween;
+}
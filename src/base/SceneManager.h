@@ -35,15 +35,20 @@ typedef union SDL_Event SDL_Event;
 
 typedef struct Window Window;
 typedef struct Graphics Graphics;
+typedef struct InputRouter InputRouter;
+typedef struct FrameStats FrameStats;
+typedef struct Tween Tween;
 
 typedef struct SceneManager SceneManager;
 
 typedef void *(*SceneManager_NewCallback)(SceneManager *sceneManager);
 typedef void (*SceneManager_DeleteCallback)(void * const self);
+// Gets every event after the input router, with mouse motion coalesced per frame
 typedef void (*SceneManager_ProcessEventCallback)(void * const self, const SDL_Event *event);
 typedef void (*SceneManager_UpdateCallback)(void * const self, double deltaTime);
 typedef void (*SceneManager_DrawCallback)(void * const self);
 typedef void (*SceneManager_TimerCallback)(void * const manager, void *userdata);
+typedef uint32_t SceneManager_TimerId;
 
 typedef struct SceneManager_CurrentScene
 {
@@ -57,11 +62,35 @@ typedef struct SceneManager_CurrentScene
 SceneManager *SceneManager_New(Window *window, Graphics *graphics);
 void SceneManager_Delete(SceneManager * const self);
 void SceneManager_GoTo(SceneManager * const self, const SceneManager_CurrentScene *scene);
-void SceneManager_AddTimer(SceneManager * const self, uint32_t interval, SceneManager_TimerCallback callback, void *userdata);
+// Timers fire from the main loop, once per frame at most for each repeating one
+SceneManager_TimerId SceneManager_AddTimer(SceneManager * const self, uint32_t interval, SceneManager_TimerCallback callback, void *userdata);
+SceneManager_TimerId SceneManager_AddRepeatingTimer(SceneManager * const self, uint32_t interval, SceneManager_TimerCallback callback, void *userdata);
+void SceneManager_CancelTimer(SceneManager * const self, SceneManager_TimerId id);
 void SceneManager_ClearTimers(SceneManager * const self);
+// Records the input of the session to a file, which SceneManager_ReplayInput plays back on the same frames.
+// While replaying live input is ignored and the loop ends with the recording
+bool SceneManager_RecordInput(SceneManager * const self, const char *filename);
+bool SceneManager_ReplayInput(SceneManager * const self, const char *filename);
+// Steps the scene clock (update delta time and timers) by a constant, 0 goes back to measured time
+void SceneManager_SetFixedDeltaTime(SceneManager * const self, double deltaTime);
+// Time each frame of the main loop took
+FrameStats *SceneManager_FrameStats(SceneManager * const self);
+// Frames end waiting for the GPU instead of swapping the window, for offscreen rendering
+void SceneManager_SetHeadless(SceneManager * const self, bool headless);
+// The main loop ends after this many frames, 0 runs until quit
+void SceneManager_SetFrameLimit(SceneManager * const self, uint64_t frames);
+// Saves directory/frame_NNNNNN.png every interval frames (0 for none) and on the last frame of the limit
+void SceneManager_SetSnapshots(SceneManager * const self, const char *directory, uint64_t interval);
+// Lowers the render scale, down to half, while the GPU time of a frame is over the budget. 0 turns it off.
+// False without GPU timer queries, the scene is then drawn at full resolution
+bool SceneManager_SetDynamicResolution(SceneManager * const self, double budgetSeconds);
 void SceneManager_Run(SceneManager * const self);
 Window *SceneManager_Window(SceneManager * const self);
 Graphics *SceneManager_Graphics(SceneManager * const self);
+// Cleared on every scene change
+InputRouter *SceneManager_InputRouter(SceneManager * const self);
+// Updated with the scene clock before the scene, cleared on every scene change
+Tween *SceneManager_Tween(SceneManager * const self);
 
 #define SCENE_MANAGER_GOTO(MANAGER, SCENE_CLASS) \
     SceneManager_GoTo(MANAGER, &(SceneManager_CurrentScene) { \
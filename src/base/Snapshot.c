@@ -0,0 +1,56 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#include "Snapshot.h"
+#include "opengl_renderer/OpenGLRenderer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+
+bool Snapshot_SavePNG(OpenGLRenderer *renderer, const char *filename)
+{
+#ifdef __EMSCRIPTEN__
+    (void)renderer;
+    printf("Unable to save %s: snapshots are not supported on the web\n", filename);
+
+    return false;
+#else
+    int width, height;
+    uint8_t *pixels = OpenGLRenderer_ReadPixels(renderer, &width, &height);
+
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormatFrom(pixels, width, height, 32, width * 4, SDL_PIXELFORMAT_RGBA32);
+    const bool saved = surface && IMG_SavePNG(surface, filename) == 0;
+
+    if (!saved)
+        printf("Unable to save %s: %s\n", filename, SDL_GetError());
+
+    SDL_FreeSurface(surface);
+    free(pixels);
+
+    return saved;
+#endif
+}
@@ -23,6 +23,9 @@ SOFTWARE.
 -------------------------------------------------------------------------------*/
 
 #include "Texture.h"
+#include "Animation.h"
+#include "AssetLoader.h"
+#include "AssetWatcher.h"
 #include "Box.h"
 #include "DataZipFile.h"
 #include "rect.h"
@@ -35,6 +38,8 @@ SOFTWARE.
 
 #include <stdio.h>
 
+static const char *FontFileName = "fonts/NotoSans-Bold.ttf";
+
 struct Texture
 {
     OpenGLRenderer *renderer;
@@ -51,9 +56,26 @@ struct Texture
 
     IRect srcrect;
     double angle;
+    Animation animation;
+    bool animated;
+
+    char *fileName;
+    bool loading;
+    bool reloading;
+    TextureFilter loadFilter;
+
+    struct
+    {
+        Texture_OnLoadedEvent function;
+        void *userdata;
+    } loadedEvent;
 };
 
 bool Texture_CreateTexture(Texture * const self, SDL_Surface *surface, TextureFilter filter);
+bool Texture_CreateTextureFromImage(Texture * const self, const Image *image, TextureFilter filter);
+void Texture_OnImageLoaded(const Image *image, void *userdata);
+void Texture_OnFileChanged(const char *fileName, void *userdata);
+void Texture_OnImageReloaded(const Image *image, void *userdata);
 
 Texture *Texture_New(OpenGLRenderer *renderer)
 {
@@ -73,6 +95,14 @@ Texture *Texture_New(OpenGLRenderer *renderer)
 
     self->srcrect = (IRect) {0, 0, 0, 0};
     self->angle = 0.0;
+    self->animated = false;
+
+    self->fileName = NULL;
+    self->loading = false;
+    self->reloading = false;
+    self->loadFilter = Nearest;
+    self->loadedEvent.function = NULL;
+    self->loadedEvent.userdata = NULL;
 
     return self;
 }
@@ -82,24 +112,46 @@ void Texture_Delete(Texture * const self)
     if (!self)
         return;
 
+    if (self->loading || self->reloading)
+        AssetLoader_Cancel(self);
+
+    AssetWatcher_Unwatch(self);
+
     Box_Delete(self->box);
 
     OpenGLRenderer_DestroyTexture(self->renderer, self->texture);
     TTF_CloseFont(self->font);
 
+    free(self->fileName);
     free(self->text);
     free(self);
 }
 
-bool Texture_LoadImageFromFile(Texture * const self, const char *fileName, TextureFilter filter)
+void Texture_LoadImageFromFile(Texture * const self, const char *fileName, TextureFilter filter)
 {
-#ifdef USE_DATA_ZIP
-    SDL_Surface *surface = IMG_Load_RW(DataZipFile_Load_RW(fileName), 1);
-#else
-    SDL_Surface *surface = IMG_Load(fileName);
-#endif
+    if (self->loading || self->reloading)
+        AssetLoader_Cancel(self);
+
+    self->loading = true;
+    self->reloading = false;
+    self->loadFilter = filter;
 
-    return Texture_CreateTexture(self, surface, filter);
+    free(self->fileName);
+
+    const size_t size = strlen(fileName) + 1;
+    self->fileName = malloc(size);
+    memcpy(self->fileName, fileName, size);
+
+    AssetLoader_LoadImage(fileName, Texture_OnImageLoaded, self);
+
+    AssetWatcher_Unwatch(self);
+    AssetWatcher_Watch(fileName, Texture_OnFileChanged, self);
+}
+
+void Texture_SetOnLoadedEvent(Texture * const self, Texture_OnLoadedEvent callback, void *userdata)
+{
+    self->loadedEvent.function = callback;
+    self->loadedEvent.userdata = userdata;
 }
 
 bool Texture_MakeText(Texture * const self)
@@ -109,9 +161,9 @@ bool Texture_MakeText(Texture * const self)
         TTF_CloseFont(self->font);
 
 #ifdef USE_DATA_ZIP
-        if (!(self->font = TTF_OpenFontRW(DataZipFile_Load_RW("fonts/NotoSans-Bold.ttf"), 1, self->fontSize)))
+        if (!(self->font = TTF_OpenFontRW(DataZipFile_Load_RW(FontFileName), 1, self->fontSize)))
 #else
-        if (!(self->font = TTF_OpenFont("fonts/NotoSans-Bold.ttf", self->fontSize)))
+        if (!(self->font = TTF_OpenFont(FontFileName, self->fontSize)))
 #endif
         {
             printf( "Failed to load font! SDL_ttf Error: %s\n", TTF_GetError());
@@ -119,6 +171,8 @@ bool Texture_MakeText(Texture * const self)
         }
 
         self->reloadFont = false;
+
+        AssetWatcher_Watch(FontFileName, Texture_OnFileChanged, self);
     }
 
     SDL_Color color = {self->textColor.r, self->textColor.g, self->textColor.b, self->textColor.a};
@@ -180,53 +234,152 @@ void Texture_SetAngle(Texture * const self, double angle)
     self->angle = angle;
 }
 
+void Texture_SetAnimation(Texture * const self, const Animation *animation)
+{
+    self->animated = animation != NULL;
+
+    if (animation)
+        self->animation = *animation;
+}
+
 void Texture_Draw(Texture * const self)
 {
+    Texture_DrawRect(self, Box_Rect(self->box));
+}
+
+void Texture_DrawRect(Texture * const self, const Rect *rect)
+{
+    if (self->loading)
+    {
+        // Placeholder until the image is uploaded
+        const Color placeholder = {200, 200, 200, 120};
+        OpenGLRenderer_FillRect(self->renderer, rect, &placeholder);
+        return;
+    }
+
     if (self->texture)
-        OpenGLRenderer_Draw(self->renderer, self->texture, &self->srcrect, Box_Rect(self->box), self->angle);
+        OpenGLRenderer_DrawAnimated(self->renderer, self->texture, &self->srcrect, rect, self->angle, self->animated ? &self->animation : NULL);
 }
 
 bool Texture_CreateTexture(Texture * const self, SDL_Surface *surface, TextureFilter filter)
 {
-    if (surface)
+    if (!surface)
     {
         OpenGLRenderer_DestroyTexture(self->renderer, self->texture);
+        self->texture = NULL;
+        printf("Unable to render surface! SDL Error: %s\n", TTF_GetError());
 
-        Image image = {
-            .width = surface->w,
-            .height = surface->h,
-            .bytesPerPixel = surface->format->BytesPerPixel,
-            .pitch = surface->pitch,
-            .rmask = surface->format->Rmask,
-            .pixels = surface->pixels,
-        };
+        return false;
+    }
 
-        self->texture = OpenGLRenderer_CreateTexture(self->renderer, &image, filter);
+    Image image = {
+        .width = surface->w,
+        .height = surface->h,
+        .bytesPerPixel = surface->format->BytesPerPixel,
+        .pitch = surface->pitch,
+        .rmask = surface->format->Rmask,
+        .pixels = surface->pixels,
+    };
 
-        if (self->texture)
-        {
-            self->w = surface->w;
-            self->h = surface->h;
-            self->srcrect.w = surface->w;
-            self->srcrect.h = surface->h;
-            Box_SetSize(self->box, surface->w, surface->h);
-        }
-        else
-        {
-            printf("Unable to update texture from rendered text! SDL Error: %s\n", SDL_GetError());
-        }
+    const bool created = Texture_CreateTextureFromImage(self, &image, filter);
+
+    SDL_FreeSurface(surface);
+
+    return created;
+}
+
+bool Texture_CreateTextureFromImage(Texture * const self, const Image *image, TextureFilter filter)
+{
+    if (self->texture)
+        OpenGLRenderer_UpdateTexture(self->renderer, self->texture, image, filter);
+    else
+        self->texture = OpenGLRenderer_CreateTexture(self->renderer, image, filter);
 
-        SDL_FreeSurface(surface);
+    if (self->texture)
+    {
+        self->w = image->width;
+        self->h = image->height;
+        self->srcrect.w = image->width;
+        self->srcrect.h = image->height;
+        Box_SetSize(self->box, image->width, image->height);
     }
     else
     {
-        self->texture = NULL;
-        printf("Unable to render surface! SDL Error: %s\n", TTF_GetError());
+        printf("Unable to update texture from rendered text! SDL Error: %s\n", SDL_GetError());
     }
 
     return self->texture != NULL;
 }
 
+void Texture_OnImageLoaded(const Image *image, void *userdata)
+{
+    Texture * const self = userdata;
+
+    self->loading = false;
+
+    const bool loaded = image && Texture_CreateTextureFromImage(self, image, self->loadFilter);
+
+    if (self->loadedEvent.function)
+        self->loadedEvent.function(self, loaded, self->loadedEvent.userdata);
+}
+
+void Texture_OnFileChanged(const char *fileName, void *userdata)
+{
+    Texture * const self = userdata;
+
+    if (self->text && strcmp(fileName, FontFileName) == 0)
+    {
+        self->reloadFont = true;
+        Texture_MakeText(self);
+        return;
+    }
+
+    if (self->loading || !self->fileName)
+        return;
+
+    if (self->reloading)
+        AssetLoader_Cancel(self);
+
+    self->reloading = true;
+
+    // The file itself was edited, its cooked copy is stale until it is cooked again
+    if (strcmp(fileName, self->fileName) == 0)
+        AssetLoader_LoadSourceImage(self->fileName, Texture_OnImageReloaded, self);
+    else
+        AssetLoader_LoadImage(self->fileName, Texture_OnImageReloaded, self);
+}
+
+void Texture_OnImageReloaded(const Image *image, void *userdata)
+{
+    Texture * const self = userdata;
+
+    self->reloading = false;
+
+    if (!image)
+    {
+        printf("Unable to reload %s, keeping the old image\n", self->fileName);
+        return;
+    }
+
+    if (!self->texture)
+    {
+        Texture_CreateTextureFromImage(self, image, self->loadFilter);
+        return;
+    }
+
+    // Swapped in place, the box and whoever draws this texture are left untouched
+    OpenGLRenderer_UpdateTexture(self->renderer, self->texture, image, self->loadFilter);
+
+    if (self->srcrect.x == 0 && self->srcrect.y == 0 && self->srcrect.w == self->w && self->srcrect.h == self->h)
+    {
+        self->srcrect.w = image->width;
+        self->srcrect.h = image->height;
+    }
+
+    self->w = image->width;
+    self->h = image->height;
+}
+
 int Texture_GetWidth(Texture * const self)
 {
     return self->w;
@@ -35,16 +35,23 @@ extern "C" {
 
 typedef struct Color Color;
 typedef struct IRect IRect;
+typedef struct Rect Rect;
+typedef struct Animation Animation;
 
 typedef struct OpenGLRenderer OpenGLRenderer;
 typedef struct Box Box;
 
 typedef struct Texture Texture;
 
+typedef void (*Texture_OnLoadedEvent)(Texture * const texture, bool loaded, void *userdata);
+
 Texture *Texture_New(OpenGLRenderer *renderer);
 void Texture_Delete(Texture * const self);
 
-bool Texture_LoadImageFromFile(Texture * const self, const char *fileName, TextureFilter filter);
+// Loads in the background, a placeholder is drawn and the loaded event is called once the image is uploaded,
+// or with loaded false if it failed
+void Texture_LoadImageFromFile(Texture * const self, const char *fileName, TextureFilter filter);
+void Texture_SetOnLoadedEvent(Texture * const self, Texture_OnLoadedEvent callback, void *userdata);
 
 bool Texture_MakeText(Texture * const self);
 void Texture_SetText(Texture * const self, const char *text);
@@ -55,8 +62,12 @@ void Texture_SetTextColorRGBA(Texture * const self, uint8_t r, uint8_t g, uint8_
 
 void Texture_SetSourceRect(Texture * const self, IRect srcrect);
 void Texture_SetAngle(Texture * const self, double angle);
+// Animated on the GPU from the renderer clock, NULL stops it. Every rect the texture is drawn in moves alike
+void Texture_SetAnimation(Texture * const self, const Animation *animation);
 
 void Texture_Draw(Texture * const self);
+// Draws in the given rect instead of the texture's box, for a texture shared by many widgets
+void Texture_DrawRect(Texture * const self, const Rect *rect);
 
 int Texture_GetWidth(Texture * const self);
 int Texture_GetHeight(Texture * const self);
@@ -0,0 +1,373 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#include "Tween.h"
+#include "Vector.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// Ids hold the generation above the index of a handle, the handle points at the packed arrays
+#define INDEX_BITS 20
+#define INDEX_MASK ((1u << INDEX_BITS) - 1)
+#define MAX_TWEENS INDEX_MASK
+
+// Every easing is a cubic of the progress t, t * (c1 + t * (c2 + t * c3)), so one loop evaluates them all
+static const float EasingCoefficients[][3] = {
+    [Easing_Linear] = {1.f, 0.f, 0.f},
+    [Easing_QuadOut] = {2.f, -1.f, 0.f},
+    [Easing_SmoothStep] = {0.f, 3.f, -2.f},
+    [Easing_CubicOut] = {3.f, -3.f, 1.f},
+};
+
+typedef struct TweenHandle
+{
+    uint32_t generation;
+    int index;
+    int nextFree;
+} TweenHandle;
+
+// Only used when a tween ends, kept apart from the arrays of the update
+typedef struct TweenEvents
+{
+    float end;
+    Tween_Callback onComplete;
+    void *completeData;
+    Tween_Callback onCancel;
+    void *cancelData;
+} TweenEvents;
+
+typedef struct FinishedTween
+{
+    Tween_Callback callback;
+    void *userdata;
+} FinishedTween;
+
+VECTOR_TYPE(TweenHandles, TweenHandle)
+VECTOR_TYPE(FinishedTweens, FinishedTween)
+
+struct Tween
+{
+    // The value is start + t * (k1 + t * (k2 + t * k3)), the easing coefficients times end - start
+    int count;
+    int capacity;
+    float *elapsed;
+    float *invDuration;
+    float *start;
+    float *k1;
+    float *k2;
+    float *k3;
+    float *values;
+    float **targets;
+    Tween_Id *ids;
+    TweenEvents *events;
+
+    TweenHandles handles;
+    int firstFree;
+    FinishedTweens finished;
+};
+
+static void Evaluate(int count, float step, float * restrict elapsed, float * restrict values, const float * restrict invDuration,
+                     const float * restrict start, const float * restrict k1, const float * restrict k2, const float * restrict k3);
+static void Grow(Tween * const self);
+static int FindIndex(Tween * const self, Tween_Id id);
+static void Remove(Tween * const self, int index);
+static void *Reallocate(void *data, size_t size);
+
+Tween *Tween_New()
+{
+    Tween * const self = malloc(sizeof (Tween));
+
+    self->count = 0;
+    self->capacity = 0;
+    self->elapsed = NULL;
+    self->invDuration = NULL;
+    self->start = NULL;
+    self->k1 = NULL;
+    self->k2 = NULL;
+    self->k3 = NULL;
+    self->values = NULL;
+    self->targets = NULL;
+    self->ids = NULL;
+    self->events = NULL;
+
+    TweenHandles_Init(&self->handles);
+    self->firstFree = -1;
+    FinishedTweens_Init(&self->finished);
+
+    return self;
+}
+
+void Tween_Delete(Tween * const self)
+{
+    if (!self)
+        return;
+
+    free(self->elapsed);
+    free(self->invDuration);
+    free(self->start);
+    free(self->k1);
+    free(self->k2);
+    free(self->k3);
+    free(self->values);
+    free(self->targets);
+    free(self->ids);
+    free(self->events);
+
+    TweenHandles_Free(&self->handles);
+    FinishedTweens_Free(&self->finished);
+    free(self);
+}
+
+Tween_Id Tween_Add(Tween * const self, float *target, float start, float end, float duration, Easing easing)
+{
+    int handleIndex = self->firstFree;
+
+    if (handleIndex < 0)
+    {
+        if (self->handles.size == MAX_TWEENS)
+        {
+            puts("Too many tweens");
+            return 0;
+        }
+
+        handleIndex = self->handles.size;
+        TweenHandles_Push(&self->handles)->generation = 0;
+    }
+    else
+    {
+        self->firstFree = self->handles.data[handleIndex].nextFree;
+    }
+
+    if (self->count == self->capacity)
+        Grow(self);
+
+    TweenHandle *handle = &self->handles.data[handleIndex];
+    const Tween_Id id = (handle->generation << INDEX_BITS) | (handleIndex + 1);
+    const int index = self->count++;
+    const float *coefficients = EasingCoefficients[easing];
+    const float delta = end - start;
+
+    handle->index = index;
+
+    // Without a duration the progress is already 1, it ends on the next update
+    self->elapsed[index] = duration > 0.f ? 0.f : 1.f;
+    self->invDuration[index] = duration > 0.f ? 1.f / duration : 1.f;
+    self->start[index] = start;
+    self->k1[index] = delta * coefficients[0];
+    self->k2[index] = delta * coefficients[1];
+    self->k3[index] = delta * coefficients[2];
+    self->values[index] = start;
+    self->targets[index] = target;
+    self->ids[index] = id;
+    self->events[index] = (TweenEvents) {end, NULL, NULL, NULL, NULL};
+
+    *target = start;
+
+    return id;
+}
+
+void Tween_SetOnComplete(Tween * const self, Tween_Id id, Tween_Callback callback, void *userdata)
+{
+    const int index = FindIndex(self, id);
+
+    if (index < 0)
+        return;
+
+    self->events[index].onComplete = callback;
+    self->events[index].completeData = userdata;
+}
+
+void Tween_SetOnCancel(Tween * const self, Tween_Id id, Tween_Callback callback, void *userdata)
+{
+    const int index = FindIndex(self, id);
+
+    if (index < 0)
+        return;
+
+    self->events[index].onCancel = callback;
+    self->events[index].cancelData = userdata;
+}
+
+void Tween_Cancel(Tween * const self, Tween_Id id)
+{
+    const int index = FindIndex(self, id);
+
+    if (index < 0)
+        return;
+
+    const TweenEvents events = self->events[index];
+
+    Remove(self, index);
+
+    if (events.onCancel)
+        events.onCancel(events.cancelData);
+}
+
+void Tween_Complete(Tween * const self, Tween_Id id)
+{
+    const int index = FindIndex(self, id);
+
+    if (index < 0)
+        return;
+
+    const TweenEvents events = self->events[index];
+
+    *self->targets[index] = events.end;
+    Remove(self, index);
+
+    if (events.onComplete)
+        events.onComplete(events.completeData);
+}
+
+void Tween_Clear(Tween * const self)
+{
+    while (self->count > 0)
+        Remove(self, self->count - 1);
+}
+
+void Tween_Update(Tween * const self, double deltaTime)
+{
+    const int count = self->count;
+
+    Evaluate(count, deltaTime, self->elapsed, self->values, self->invDuration, self->start, self->k1, self->k2, self->k3);
+
+    // The stores through the targets can alias anything, so they stay out of the evaluation loop
+    for (int i = 0; i < count; ++i)
+        *self->targets[i] = self->values[i];
+
+    // Backwards, the last tween takes the place of a finished one. Callbacks run once the arrays are
+    // consistent again, they may add or cancel tweens
+    for (int i = count; i-- > 0;)
+    {
+        if (self->elapsed[i] * self->invDuration[i] < 1.f)
+            continue;
+
+        const TweenEvents *events = &self->events[i];
+
+        *self->targets[i] = events->end;
+
+        if (events->onComplete)
+            *FinishedTweens_Push(&self->finished) = (FinishedTween) {events->onComplete, events->completeData};
+
+        Remove(self, i);
+    }
+
+    for (size_t i = 0; i < self->finished.size; ++i)
+        self->finished.data[i].callback(self->finished.data[i].userdata);
+
+    self->finished.size = 0;
+}
+
+int Tween_Count(Tween * const self)
+{
+    return self->count;
+}
+
+void Evaluate(int count, float step, float * restrict elapsed, float * restrict values, const float * restrict invDuration,
+              const float * restrict start, const float * restrict k1, const float * restrict k2, const float * restrict k3)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        elapsed[i] += step;
+
+        const float progress = elapsed[i] * invDuration[i];
+        const float t = progress < 1.f ? progress : 1.f;
+
+        values[i] = start[i] + t * (k1[i] + t * (k2[i] + t * k3[i]));
+    }
+}
+
+void Grow(Tween * const self)
+{
+    const int capacity = self->capacity ? self->capacity * 2 : 64;
+
+    self->elapsed = Reallocate(self->elapsed, sizeof (float) * capacity);
+    self->invDuration = Reallocate(self->invDuration, sizeof (float) * capacity);
+    self->start = Reallocate(self->start, sizeof (float) * capacity);
+    self->k1 = Reallocate(self->k1, sizeof (float) * capacity);
+    self->k2 = Reallocate(self->k2, sizeof (float) * capacity);
+    self->k3 = Reallocate(self->k3, sizeof (float) * capacity);
+    self->values = Reallocate(self->values, sizeof (float) * capacity);
+    self->targets = Reallocate(self->targets, sizeof (float *) * capacity);
+    self->ids = Reallocate(self->ids, sizeof (Tween_Id) * capacity);
+    self->events = Reallocate(self->events, sizeof (TweenEvents) * capacity);
+    self->capacity = capacity;
+}
+
+int FindIndex(Tween * const self, Tween_Id id)
+{
+    const int handleIndex = (int) (id & INDEX_MASK) - 1;
+
+    if (handleIndex < 0 || handleIndex >= (int) self->handles.size)
+        return -1;
+
+    const TweenHandle *handle = &self->handles.data[handleIndex];
+
+    if (handle->generation != id >> INDEX_BITS)
+        return -1;
+
+    return handle->index;
+}
+
+void Remove(Tween * const self, int index)
+{
+    const int last = --self->count;
+    TweenHandle *handle = &self->handles.data[(self->ids[index] & INDEX_MASK) - 1];
+
+    // Old ids stop matching
+    handle->generation = (handle->generation + 1) & (UINT32_MAX >> INDEX_BITS);
+    handle->index = -1;
+    handle->nextFree = self->firstFree;
+    self->firstFree = handle - self->handles.data;
+
+    if (index == last)
+        return;
+
+    self->elapsed[index] = self->elapsed[last];
+    self->invDuration[index] = self->invDuration[last];
+    self->start[index] = self->start[last];
+    self->k1[index] = self->k1[last];
+    self->k2[index] = self->k2[last];
+    self->k3[index] = self->k3[last];
+    self->values[index] = self->values[last];
+    self->targets[index] = self->targets[last];
+    self->ids[index] = self->ids[last];
+    self->events[index] = self->events[last];
+
+    self->handles.data[(self->ids[index] & INDEX_MASK) - 1].index = index;
+}
+
+void *Reallocate(void *data, size_t size)
+{
+    data = realloc(data, size);
+
+    if (!data)
+    {
+        puts("Out of memory growing the tweens");
+        exit(EXIT_FAILURE);
+    }
+
+    return data;
+}
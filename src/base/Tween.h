@@ -0,0 +1,65 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include "Animation.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Animates float properties on the CPU. Tweens are kept as a structure of arrays, packed without holes,
+// and every frame is one branchless loop over them, so thousands running at once stay cheap.
+// The easings are those of Animation, which the renderer evaluates on the GPU instead
+
+typedef struct Tween Tween;
+
+typedef void (*Tween_Callback)(void *userdata);
+
+// 0 is never a valid tween, ids of finished or canceled tweens are not reused for a long time
+typedef uint32_t Tween_Id;
+
+Tween *Tween_New();
+void Tween_Delete(Tween * const self);
+
+// Sets *target to start now, then eases it to end over duration seconds of Tween_Update.
+// The target has to outlive the tween, or the tween has to be canceled first
+Tween_Id Tween_Add(Tween * const self, float *target, float start, float end, float duration, Easing easing);
+// Called once the tween reaches its end, or is completed early, after the target has the end value
+void Tween_SetOnComplete(Tween * const self, Tween_Id id, Tween_Callback callback, void *userdata);
+void Tween_SetOnCancel(Tween * const self, Tween_Id id, Tween_Callback callback, void *userdata);
+// Both do nothing for a tween that already finished. Canceling leaves the target where it is
+void Tween_Cancel(Tween * const self, Tween_Id id);
+void Tween_Complete(Tween * const self, Tween_Id id);
+// Drops every tween without calling anything
+void Tween_Clear(Tween * const self);
+void Tween_Update(Tween * const self, double deltaTime);
+int Tween_Count(Tween * const self);
+
+#ifdef __cplusplus
+}
+#endif
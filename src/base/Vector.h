@@ -0,0 +1,126 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Typed contiguous dynamic array, the functions are generated once per element type:
+//
+//   VECTOR_TYPE(IntVector, int)
+//
+//   IntVector numbers;
+//   IntVector_Init(&numbers);
+//   *IntVector_Push(&numbers) = 42;
+//   IntVector_Free(&numbers);
+//
+// Pointers into data are invalidated by anything that grows the array
+
+#define VECTOR_TYPE(NAME, TYPE) \
+    typedef struct NAME \
+    { \
+        TYPE *data; \
+        size_t size; \
+        size_t capacity; \
+    } NAME; \
+    \
+    static inline void NAME##_Init(NAME * const self) \
+    { \
+        self->data = NULL; \
+        self->size = 0; \
+        self->capacity = 0; \
+    } \
+    \
+    static inline void NAME##_Free(NAME * const self) \
+    { \
+        free(self->data); \
+        NAME##_Init(self); \
+    } \
+    \
+    static inline void NAME##_Reserve(NAME * const self, size_t capacity) \
+    { \
+        if (capacity <= self->capacity) \
+            return; \
+        \
+        size_t grown = self->capacity ? self->capacity * 2 : 8; \
+        \
+        if (grown < capacity) \
+            grown = capacity; \
+        \
+        TYPE *data = realloc(self->data, grown * sizeof (TYPE)); \
+        \
+        if (!data) \
+        { \
+            puts("Out of memory growing " #NAME); \
+            exit(EXIT_FAILURE); \
+        } \
+        \
+        self->data = data; \
+        self->capacity = grown; \
+    } \
+    \
+    /* New elements are left uninitialized */ \
+    static inline void NAME##_Resize(NAME * const self, size_t size) \
+    { \
+        NAME##_Reserve(self, size); \
+        self->size = size; \
+    } \
+    \
+    static inline TYPE *NAME##_Push(NAME * const self) \
+    { \
+        NAME##_Reserve(self, self->size + 1); \
+        return &self->data[self->size++]; \
+    } \
+    \
+    static inline void NAME##_Pop(NAME * const self) \
+    { \
+        --self->size; \
+    } \
+    \
+    static inline void NAME##_Remove(NAME * const self, size_t index) \
+    { \
+        memmove(&self->data[index], &self->data[index + 1], (self->size - index - 1) * sizeof (TYPE)); \
+        --self->size; \
+    } \
+    \
+    /* O(1), the last element takes the place of the removed one */ \
+    static inline void NAME##_SwapRemove(NAME * const self, size_t index) \
+    { \
+        self->data[index] = self->data[--self->size]; \
+    } \
+    \
+    static inline void NAME##_Clear(NAME * const self) \
+    { \
+        self->size = 0; \
+    }
+
+#ifdef __cplusplus
+}
+#endif
@@ -36,7 +36,10 @@ struct Window
 {
     SDL_Window *window;
     SDL_GLContext context;
+
+    // In points, and in pixels for the GL viewport. They differ on HiDPI displays
     IVec2 size;
+    IVec2 drawableSize;
 };
 
 typedef struct OpenGLList
@@ -60,11 +63,12 @@ static const OpenGLList glList[] = {
 
 static bool CreateGLContext(Window * const self);
 
-Window *Window_New(int width, int height, const char *title)
+Window *Window_New(int width, int height, const char *title, bool hidden)
 {
     Window * const self = malloc(sizeof (Window));
 
     self->size = (IVec2) {.w = width, .h = height};
+    self->drawableSize = self->size;
     self->context = NULL;
 
     self->window = SDL_CreateWindow(title,
@@ -72,7 +76,8 @@ Window *Window_New(int width, int height, const char *title)
                                 SDL_WINDOWPOS_UNDEFINED,
                                 self->size.w,
                                 self->size.h,
-                                SDL_WINDOW_SHOWN | SDL_WINDOW_OPENGL);
+                                (hidden ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN) | SDL_WINDOW_OPENGL
+                                | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI);
 
     if (!self->window)
     {
@@ -87,6 +92,10 @@ Window *Window_New(int width, int height, const char *title)
         return NULL;
     }
 
+    // The scene is laid out for at least the initial size
+    SDL_SetWindowMinimumSize(self->window, width, height);
+    Window_UpdateSize(self);
+
     return self;
 }
 
@@ -110,6 +119,8 @@ bool CreateGLContext(Window * const self)
         SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, gl->profile);
         SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, gl->majorVersion);
         SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, gl->minorVersion);
+        // For the front to back pass of the opaque draws
+        SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 16);
 
         self->context = SDL_GL_CreateContext(self->window);
 
@@ -157,7 +168,26 @@ IVec2 Window_GetSize(Window * const self)
     return self->size;
 }
 
+IVec2 Window_GetDrawableSize(Window * const self)
+{
+    return self->drawableSize;
+}
+
+void Window_UpdateSize(Window * const self)
+{
+    SDL_GetWindowSize(self->window, &self->size.w, &self->size.h);
+    SDL_GL_GetDrawableSize(self->window, &self->drawableSize.w, &self->drawableSize.h);
+}
+
 void Window_SwapWindow(Window * const self)
 {
     SDL_GL_SwapWindow(self->window);
 }
+
+void Window_SetVSync(Window * const self, bool enabled)
+{
+    (void)self;
+
+    if (SDL_GL_SetSwapInterval(enabled ? 1 : 0) < 0)
+        printf("Unable to %s VSync: %s\n", enabled ? "enable" : "disable", SDL_GetError());
+}
@@ -25,6 +25,9 @@ SOFTWARE.
 #pragma once
 
 #include "rect.h"
+
+#include <stdbool.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -34,13 +37,19 @@ typedef struct SDL_Window SDL_Window;
 typedef struct IRect IRect;
 typedef struct Window Window;
 
-Window *Window_New(int width, int height, const char *title);
+// A hidden window still gets a GL context, for headless rendering
+Window *Window_New(int width, int height, const char *title, bool hidden);
 void Window_Delete(Window * const self);
 void Window_SetWindowIcon(Window * const self, const char *filename);
 void Window_SetWindowTitle(Window * const self, const char *title);
 SDL_Window *Window_GetSDLWindow(Window * const self);
 IVec2 Window_GetSize(Window * const self);
+IVec2 Window_GetDrawableSize(Window * const self);
+
+// Reads the sizes again, after SDL_WINDOWEVENT_SIZE_CHANGED
+void Window_UpdateSize(Window * const self);
 void Window_SwapWindow(Window * const self);
+void Window_SetVSync(Window * const self, bool enabled);
 
 #ifdef __cplusplus
 }
@@ -37,3 +37,13 @@ static inline bool IsOpenGL_ES_3() { return GLAD_GL_ES_VERSION_3_0 == 1; }
 #else
 static inline bool IsOpenGL_3() { return GLAD_GL_VERSION_3_3 == 1; }
 #endif
+
+// OpenGL 3.3 / OpenGL ES 3.0 / WebGL 2.0
+static inline bool IsModernOpenGL()
+{
+#ifdef RENDERER_GL_ES
+    return IsOpenGL_ES_3();
+#else
+    return IsOpenGL_3();
+#endif
+}
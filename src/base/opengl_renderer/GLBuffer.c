@@ -23,25 +23,43 @@ SOFTWARE.
 -------------------------------------------------------------------------------*/
 
 #include "GLBuffer.h"
+#include "GLExtensions.h"
 #include "GLProgram.h"
+#include "GLState.h"
+#include "GLStreamBuffer.h"
 
 #include <malloc.h>
 
+static const GLsizeiptr StreamBufferSize = 512 * 1024;
+
+// Four segments of GLBUFFER_MAX_PARTICLES, so a whole particle system goes in a single draw
+static const GLsizeiptr ParticleBufferSize = 4 * GLBUFFER_MAX_PARTICLES * sizeof (ParticleVertex);
+
 struct GLBuffer
 {
-    GLuint vao;
-    GLuint positionVBO, colorVBO, elementBuffer;
+    GLState *state;
+    bool vertexArrays;
+    GLuint vaos[_Type_size];
+    GLuint positionVBO, elementBuffer;
+    GLStreamBuffer *streamBuffer;
+    GLStreamBuffer *particleBuffer;
     int indicesCount;
 };
 
-GLBuffer *GLBuffer_New()
+GLBuffer *GLBuffer_New(GLState *state)
 {
     GLBuffer * const self = malloc(sizeof (GLBuffer));
 
-    self->vao = 0;
+    self->state = state;
+    self->vertexArrays = false;
+
+    for (int i = 0; i < _Type_size; ++i)
+        self->vaos[i] = 0;
+
     self->positionVBO = 0;
-    self->colorVBO = 0;
     self->elementBuffer = 0;
+    self->streamBuffer = GLStreamBuffer_New(state, StreamBufferSize);
+    self->particleBuffer = GLStreamBuffer_New(state, ParticleBufferSize);
     self->indicesCount = 0;
 
     return self;
@@ -52,27 +70,27 @@ void GLBuffer_Delete(GLBuffer * const self)
     if (!self)
         return;
 
-    glDeleteBuffers(1, &self->positionVBO);
-    glDeleteBuffers(1, &self->elementBuffer);
-    glDeleteBuffers(1, &self->colorVBO);
+    GLState_DeleteBuffer(self->state, self->positionVBO);
+    GLState_DeleteBuffer(self->state, self->elementBuffer);
+    GLStreamBuffer_Delete(self->streamBuffer);
+    GLStreamBuffer_Delete(self->particleBuffer);
 
-#ifndef RENDERER_GL_ES
-    if (IsOpenGL_3())
-        glDeleteVertexArrays(1, &self->vao);
-#endif
+    if (self->vertexArrays)
+        for (int i = 0; i < _Type_size; ++i)
+            GLState_DeleteVertexArray(self->state, self->vaos[i]);
 
     free(self);
 }
 
-void GLBuffer_Init(GLBuffer * const self)
+void GLBuffer_Init(GLBuffer * const self, const GLExtensions *extensions)
 {
-#ifndef RENDERER_GL_ES
-    if (IsOpenGL_3())
+    self->vertexArrays = extensions->vertexArrayObject;
+
+    if (self->vertexArrays)
     {
-        glGenVertexArrays(1, &self->vao);
-        glBindVertexArray(self->vao);
+        glGenVertexArrays(_Type_size, self->vaos);
+        GLState_BindVertexArray(self->state, self->vaos[0]);
     }
-#endif
 
     const ivec3 indices[2] = {
         {0, 1, 2},
@@ -89,54 +107,211 @@ void GLBuffer_Init(GLBuffer * const self)
     };
 
     glGenBuffers(1, &self->elementBuffer);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, self->elementBuffer);
+    GLState_BindBuffer(self->state, GL_ELEMENT_ARRAY_BUFFER, self->elementBuffer);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof (indices), indices, GL_STATIC_DRAW);
 
     glGenBuffers(1, &self->positionVBO);
-    glBindBuffer(GL_ARRAY_BUFFER, self->positionVBO);
+    GLState_BindBuffer(self->state, GL_ARRAY_BUFFER, self->positionVBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof (vertices), vertices, GL_STATIC_DRAW);
 
-    glGenBuffers(1, &self->colorVBO);
-    glBindBuffer(GL_ARRAY_BUFFER, self->colorVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof (vec4[4]), NULL, GL_DYNAMIC_DRAW);
+    GLStreamBuffer_Init(self->streamBuffer);
+    GLStreamBuffer_Init(self->particleBuffer);
 }
 
-void GLBuffer_EnablePositionVBO(GLBuffer * const self, const GLProgramLocation *program)
+void GLBuffer_InitVertexArray(GLBuffer * const self, const GLProgramLocation *program)
 {
-    glBindBuffer(GL_ARRAY_BUFFER, self->positionVBO);
+    if (!self->vertexArrays)
+        return;
 
-    glEnableVertexAttribArray(program->aPosition);
-    glVertexAttribPointer(program->aPosition, 2, GL_FLOAT, GL_FALSE, sizeof (Vertex), NULL);
+    // Everything that does not change between draws is recorded in the VAO once
+    GLState_BindVertexArray(self->state, self->vaos[program->type]);
+    GLState_BindBuffer(self->state, GL_ELEMENT_ARRAY_BUFFER, self->elementBuffer);
+    GLState_BindBuffer(self->state, GL_ARRAY_BUFFER, self->positionVBO);
+
+    // The particle point sprites have no corners
+    if (program->aPosition != -1)
+    {
+        glEnableVertexAttribArray(program->aPosition);
+        glVertexAttribPointer(program->aPosition, 2, GL_FLOAT, GL_FALSE, sizeof (Vertex), (void *) 0);
+    }
 
     if (program->aUV != -1)
     {
         glEnableVertexAttribArray(program->aUV);
         glVertexAttribPointer(program->aUV, 2, GL_FLOAT, GL_FALSE, sizeof (Vertex), (void *) offsetof(Vertex, UV));
     }
+
+    // Streamed attribs get their pointer on each draw, the instanced ones are always fed per instance
+    const bool instanced = IsModernOpenGL();
+    const GLint streamed[] = {program->aColor, program->aTransform, program->aTranslation, program->aSource, program->aAnimation, program->aSlide,
+                              program->aParticle};
+
+    for (size_t i = 0; i < sizeof (streamed) / sizeof (GLint); ++i)
+    {
+        if (streamed[i] == -1)
+            continue;
+
+        glEnableVertexAttribArray(streamed[i]);
+
+        if (instanced)
+            glVertexAttribDivisor(streamed[i], 1);
+    }
+}
+
+void GLBuffer_EnablePositionVBO(GLBuffer * const self, const GLProgramLocation *program)
+{
+    if (self->vertexArrays)
+    {
+        GLState_BindVertexArray(self->state, self->vaos[program->type]);
+        return;
+    }
+
+    GLState_BindBuffer(self->state, GL_ARRAY_BUFFER, self->positionVBO);
+
+    if (program->aPosition != -1)
+    {
+        GLState_EnableVertexAttrib(self->state, program->aPosition);
+        GLState_VertexAttribPointer(self->state, program->aPosition, 2, sizeof (Vertex), 0);
+    }
+
+    if (program->aUV != -1)
+    {
+        GLState_EnableVertexAttrib(self->state, program->aUV);
+        GLState_VertexAttribPointer(self->state, program->aUV, 2, sizeof (Vertex), offsetof(Vertex, UV));
+    }
 }
 
 void GLBuffer_DisablePositionVBO(GLBuffer * const self, const GLProgramLocation *program)
 {
-    glDisableVertexAttribArray(program->aPosition);
+    if (self->vertexArrays)
+        return;
+
+    if (program->aPosition != -1)
+        GLState_DisableVertexAttrib(self->state, program->aPosition);
 
     if (program->aUV != -1)
-        glDisableVertexAttribArray(program->aUV);
+        GLState_DisableVertexAttrib(self->state, program->aUV);
 }
 
 void GLBuffer_EnableColorVBO(GLBuffer * const self, const GLProgramLocation *program, const vec4 colors[4])
 {
-    glEnableVertexAttribArray(program->aColor);
-    glBindBuffer(GL_ARRAY_BUFFER, self->colorVBO);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof (vec4[4]), colors);
-    glVertexAttribPointer(program->aColor, 4, GL_FLOAT, GL_FALSE, 0, 0);
+    const GLintptr offset = GLStreamBuffer_Upload(self->streamBuffer, colors, sizeof (vec4[4]));
+
+    // The ring buffer offset moves on every draw, so only the pointer is set again
+    if (self->vertexArrays)
+    {
+        glVertexAttribPointer(program->aColor, 4, GL_FLOAT, GL_FALSE, 0, (void *) offset);
+        return;
+    }
+
+    GLState_EnableVertexAttrib(self->state, program->aColor);
+    GLState_VertexAttribPointer(self->state, program->aColor, 4, 0, offset);
 }
 
 void GLBuffer_DisableColorVBO(GLBuffer * const self, const GLProgramLocation *program)
 {
-    glDisableVertexAttribArray(program->aColor);
+    if (self->vertexArrays)
+        return;
+
+    GLState_DisableVertexAttrib(self->state, program->aColor);
+}
+
+static void EnableInstanceAttrib(GLBuffer * const self, GLint location, GLint size, GLintptr offset)
+{
+    if (location == -1)
+        return;
+
+    if (self->vertexArrays)
+    {
+        glVertexAttribPointer(location, size, GL_FLOAT, GL_FALSE, sizeof (Instance), (void *) offset);
+        return;
+    }
+
+    GLState_EnableVertexAttrib(self->state, location);
+    GLState_VertexAttribPointer(self->state, location, size, sizeof (Instance), offset);
+    GLState_VertexAttribDivisor(self->state, location, 1);
+}
+
+static void DisableInstanceAttrib(GLState * const state, GLint location)
+{
+    // The divisor stays set, these locations are only ever fed per instance
+    if (location != -1)
+        GLState_DisableVertexAttrib(state, location);
+}
+
+void GLBuffer_EnableInstanceVBO(GLBuffer * const self, const GLProgramLocation *program, const Instance *instances, int count)
+{
+    const GLintptr offset = GLStreamBuffer_Upload(self->streamBuffer, instances, sizeof (Instance) * count);
+
+    EnableInstanceAttrib(self, program->aTransform, 4, offset + offsetof(Instance, transform));
+    EnableInstanceAttrib(self, program->aTranslation, 3, offset + offsetof(Instance, translation));
+    EnableInstanceAttrib(self, program->aColor, 4, offset + offsetof(Instance, color));
+    EnableInstanceAttrib(self, program->aSource, 4, offset + offsetof(Instance, source));
+    EnableInstanceAttrib(self, program->aAnimation, 4, offset + offsetof(Instance, animation));
+    EnableInstanceAttrib(self, program->aSlide, 4, offset + offsetof(Instance, slide));
+}
+
+void GLBuffer_DisableInstanceVBO(GLBuffer * const self, const GLProgramLocation *program)
+{
+    if (self->vertexArrays)
+        return;
+
+    DisableInstanceAttrib(self->state, program->aTransform);
+    DisableInstanceAttrib(self->state, program->aTranslation);
+    DisableInstanceAttrib(self->state, program->aColor);
+    DisableInstanceAttrib(self->state, program->aSource);
+    DisableInstanceAttrib(self->state, program->aAnimation);
+    DisableInstanceAttrib(self->state, program->aSlide);
+}
+
+static void EnableParticleAttrib(GLBuffer * const self, GLint location, GLint size, GLenum type, GLboolean normalized, GLintptr offset)
+{
+    if (self->vertexArrays)
+    {
+        glVertexAttribPointer(location, size, type, normalized, sizeof (ParticleVertex), (void *) offset);
+        return;
+    }
+
+    // Without vertex arrays this is OpenGL 2.1 / OpenGL ES 2.0, one point per particle and no divisor
+    GLState_EnableVertexAttrib(self->state, location);
+    GLState_VertexAttribPointerType(self->state, location, size, type, normalized, sizeof (ParticleVertex), offset);
+}
+
+void GLBuffer_EnableParticleVBO(GLBuffer * const self, const GLProgramLocation *program, const ParticleVertex *particles, int count)
+{
+    const GLintptr offset = GLStreamBuffer_Upload(self->particleBuffer, particles, sizeof (ParticleVertex) * count);
+
+    EnableParticleAttrib(self, program->aParticle, 3, GL_FLOAT, GL_FALSE, offset + offsetof(ParticleVertex, position));
+    EnableParticleAttrib(self, program->aColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, offset + offsetof(ParticleVertex, color));
+}
+
+void GLBuffer_DisableParticleVBO(GLBuffer * const self, const GLProgramLocation *program)
+{
+    if (self->vertexArrays)
+        return;
+
+    GLState_DisableVertexAttrib(self->state, program->aParticle);
+    GLState_DisableVertexAttrib(self->state, program->aColor);
 }
 
 void GLBuffer_DrawElements(GLBuffer * const self)
 {
+    GLState_ApplyVertexAttribs(self->state);
     glDrawElements(GL_TRIANGLES, self->indicesCount, GL_UNSIGNED_INT, NULL);
 }
+
+void GLBuffer_DrawElementsInstanced(GLBuffer * const self, int count)
+{
+    GLState_ApplyVertexAttribs(self->state);
+    glDrawElementsInstanced(GL_TRIANGLES, self->indicesCount, GL_UNSIGNED_INT, NULL, count);
+}
+
+void GLBuffer_DrawParticles(GLBuffer * const self, int count)
+{
+    GLState_ApplyVertexAttribs(self->state);
+
+    if (IsModernOpenGL())
+        glDrawElementsInstanced(GL_TRIANGLES, self->indicesCount, GL_UNSIGNED_INT, NULL, count);
+    else
+        glDrawArrays(GL_POINTS, 0, count);
+}
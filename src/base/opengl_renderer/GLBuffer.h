@@ -27,33 +27,69 @@ SOFTWARE.
 #include "GL.h"
 
 #include <cglm/vec4.h>
+#include <cglm/vec3.h>
 #include <cglm/vec2.h>
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#define GLBUFFER_MAX_INSTANCES 512
+#define GLBUFFER_MAX_PARTICLES 65536
+
 typedef struct Vertex
 {
     vec2 position;
     vec2 UV;
 } Vertex;
 
+// Per-quad data of the instanced path (OpenGL 3.3 / OpenGL ES 3.0)
+typedef struct Instance
+{
+    vec4 transform; // first two columns of the 2D affine matrix
+    vec3 translation; // and the depth of the opaque pass
+    vec4 color;
+    vec4 source; // UV rect, or width, height, corner radius and stroke thickness of a shape
+    vec4 animation; // start time, angular velocity, pulse amplitude and frequency, see Animation
+    vec4 slide; // offset at the start, duration, easing
+} Instance;
+
+// A quad per instance on OpenGL 3.3 / OpenGL ES 3.0, a point sprite before
+typedef struct ParticleVertex
+{
+    vec2 position; // center
+    float size;
+    uint8_t color[4];
+} ParticleVertex;
+
+typedef struct GLExtensions GLExtensions;
 typedef struct GLProgramLocation GLProgramLocation;
+typedef struct GLState GLState;
 
 typedef struct GLBuffer GLBuffer;
 
-GLBuffer *GLBuffer_New();
+GLBuffer *GLBuffer_New(GLState *state);
 void GLBuffer_Delete(GLBuffer * const self);
 
-void GLBuffer_Init(GLBuffer * const self);
+void GLBuffer_Init(GLBuffer * const self, const GLExtensions *extensions);
+void GLBuffer_InitVertexArray(GLBuffer * const self, const GLProgramLocation *program);
 void GLBuffer_EnablePositionVBO(GLBuffer * const self, const GLProgramLocation *program);
 void GLBuffer_DisablePositionVBO(GLBuffer * const self, const GLProgramLocation *program);
 
 void GLBuffer_EnableColorVBO(GLBuffer * const self, const GLProgramLocation *program, const vec4 colors[4]);
 void GLBuffer_DisableColorVBO(GLBuffer * const self, const GLProgramLocation *program);
 
+void GLBuffer_EnableInstanceVBO(GLBuffer * const self, const GLProgramLocation *program, const Instance *instances, int count);
+void GLBuffer_DisableInstanceVBO(GLBuffer * const self, const GLProgramLocation *program);
+
+void GLBuffer_EnableParticleVBO(GLBuffer * const self, const GLProgramLocation *program, const ParticleVertex *particles, int count);
+void GLBuffer_DisableParticleVBO(GLBuffer * const self, const GLProgramLocation *program);
+
 void GLBuffer_DrawElements(GLBuffer * const self);
+void GLBuffer_DrawElementsInstanced(GLBuffer * const self, int count);
+void GLBuffer_DrawParticles(GLBuffer * const self, int count);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,186 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#include "GLExtensions.h"
+
+#include <stdio.h>
+
+#include <SDL2/SDL_video.h>
+
+#ifndef RENDERER_GL_ES
+PFNGLGETPROGRAMBINARYPROC glad_glGetProgramBinary = NULL;
+PFNGLPROGRAMBINARYPROC glad_glProgramBinary = NULL;
+PFNGLPROGRAMPARAMETERIPROC glad_glProgramParameteri = NULL;
+#else
+PFNGLGETQUERYOBJECTUI64VPROC glad_glGetQueryObjectui64v = NULL;
+#endif
+
+static bool LoadVertexArrayObject();
+static bool LoadProgramBinary();
+static bool HasTextureETC2();
+static bool HasTextureS3TC();
+static bool LoadTimerQuery();
+
+void GLExtensions_Load(GLExtensions *extensions)
+{
+    extensions->vertexArrayObject = LoadVertexArrayObject();
+    extensions->programBinary = LoadProgramBinary();
+    extensions->textureETC2 = HasTextureETC2();
+    extensions->textureS3TC = HasTextureS3TC();
+    extensions->timerQuery = LoadTimerQuery();
+
+    printf("GL vertex array objects: %s\n", extensions->vertexArrayObject ? "yes" : "no");
+    printf("GL program binaries: %s\n", extensions->programBinary ? "yes" : "no");
+    printf("GL compressed textures: ETC2 %s, S3TC %s\n", extensions->textureETC2 ? "yes" : "no", extensions->textureS3TC ? "yes" : "no");
+    printf("GL timer queries: %s\n", extensions->timerQuery ? "yes" : "no");
+}
+
+bool LoadVertexArrayObject()
+{
+    if (IsModernOpenGL())
+        return true;
+
+    // The extension entry points take the place of the core ones, so the rest of the code calls glBindVertexArray
+#ifdef RENDERER_GL_ES
+    if (!SDL_GL_ExtensionSupported("GL_OES_vertex_array_object"))
+        return false;
+
+    glad_glGenVertexArrays = (PFNGLGENVERTEXARRAYSPROC) SDL_GL_GetProcAddress("glGenVertexArraysOES");
+    glad_glBindVertexArray = (PFNGLBINDVERTEXARRAYPROC) SDL_GL_GetProcAddress("glBindVertexArrayOES");
+    glad_glDeleteVertexArrays = (PFNGLDELETEVERTEXARRAYSPROC) SDL_GL_GetProcAddress("glDeleteVertexArraysOES");
+#else
+    if (!SDL_GL_ExtensionSupported("GL_ARB_vertex_array_object"))
+        return false;
+
+    glad_glGenVertexArrays = (PFNGLGENVERTEXARRAYSPROC) SDL_GL_GetProcAddress("glGenVertexArrays");
+    glad_glBindVertexArray = (PFNGLBINDVERTEXARRAYPROC) SDL_GL_GetProcAddress("glBindVertexArray");
+    glad_glDeleteVertexArrays = (PFNGLDELETEVERTEXARRAYSPROC) SDL_GL_GetProcAddress("glDeleteVertexArrays");
+#endif
+
+    return glad_glGenVertexArrays && glad_glBindVertexArray && glad_glDeleteVertexArrays;
+}
+
+bool LoadProgramBinary()
+{
+#ifdef __EMSCRIPTEN__
+    // WebGL never exposes program binaries
+    return false;
+#else
+#ifdef RENDERER_GL_ES
+    if (!IsOpenGL_ES_3())
+    {
+        if (!SDL_GL_ExtensionSupported("GL_OES_get_program_binary"))
+            return false;
+
+        glad_glGetProgramBinary = (PFNGLGETPROGRAMBINARYPROC) SDL_GL_GetProcAddress("glGetProgramBinaryOES");
+        glad_glProgramBinary = (PFNGLPROGRAMBINARYPROC) SDL_GL_GetProcAddress("glProgramBinaryOES");
+    }
+#else
+    GLint major = 0, minor = 0;
+
+    if (IsOpenGL_3())
+    {
+        glGetIntegerv(GL_MAJOR_VERSION, &major);
+        glGetIntegerv(GL_MINOR_VERSION, &minor);
+    }
+
+    if (major * 10 + minor < 41 && !SDL_GL_ExtensionSupported("GL_ARB_get_program_binary"))
+        return false;
+
+    glad_glGetProgramBinary = (PFNGLGETPROGRAMBINARYPROC) SDL_GL_GetProcAddress("glGetProgramBinary");
+    glad_glProgramBinary = (PFNGLPROGRAMBINARYPROC) SDL_GL_GetProcAddress("glProgramBinary");
+    glad_glProgramParameteri = (PFNGLPROGRAMPARAMETERIPROC) SDL_GL_GetProcAddress("glProgramParameteri");
+#endif
+
+    if (!glad_glGetProgramBinary || !glad_glProgramBinary)
+        return false;
+
+    // A driver may support the entry points without any binary format
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+
+    return formats > 0;
+#endif
+}
+
+bool HasTextureETC2()
+{
+#if defined(__EMSCRIPTEN__)
+    // Not part of WebGL 2.0, mostly exposed by mobile browsers
+    return SDL_GL_ExtensionSupported("GL_WEBGL_compressed_texture_etc")
+            || SDL_GL_ExtensionSupported("WEBGL_compressed_texture_etc");
+#elif defined(RENDERER_GL_ES)
+    return IsOpenGL_ES_3();
+#else
+    // Desktop drivers that expose it through GL_ARB_ES3_compatibility mostly decode it on the CPU
+    return false;
+#endif
+}
+
+bool HasTextureS3TC()
+{
+#ifdef __EMSCRIPTEN__
+    return SDL_GL_ExtensionSupported("GL_WEBGL_compressed_texture_s3tc")
+            || SDL_GL_ExtensionSupported("WEBGL_compressed_texture_s3tc");
+#else
+    return SDL_GL_ExtensionSupported("GL_EXT_texture_compression_s3tc");
+#endif
+}
+
+bool LoadTimerQuery()
+{
+#if defined(__EMSCRIPTEN__)
+    // Browsers mostly hide GPU timings, EXT_disjoint_timer_query_webgl2 is rarely exposed
+    return false;
+#elif defined(RENDERER_GL_ES)
+    if (!SDL_GL_ExtensionSupported("GL_EXT_disjoint_timer_query"))
+        return false;
+
+    // Before OpenGL ES 3.0 the query objects come from the extension too
+    if (!IsOpenGL_ES_3())
+    {
+        glad_glGenQueries = (PFNGLGENQUERIESPROC) SDL_GL_GetProcAddress("glGenQueriesEXT");
+        glad_glDeleteQueries = (PFNGLDELETEQUERIESPROC) SDL_GL_GetProcAddress("glDeleteQueriesEXT");
+        glad_glBeginQuery = (PFNGLBEGINQUERYPROC) SDL_GL_GetProcAddress("glBeginQueryEXT");
+        glad_glEndQuery = (PFNGLENDQUERYPROC) SDL_GL_GetProcAddress("glEndQueryEXT");
+        glad_glGetQueryObjectuiv = (PFNGLGETQUERYOBJECTUIVPROC) SDL_GL_GetProcAddress("glGetQueryObjectuivEXT");
+    }
+
+    glad_glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC) SDL_GL_GetProcAddress("glGetQueryObjectui64vEXT");
+
+    return glad_glGenQueries && glad_glDeleteQueries && glad_glBeginQuery && glad_glEndQuery
+            && glad_glGetQueryObjectuiv && glad_glGetQueryObjectui64v;
+#else
+    if (IsOpenGL_3())
+        return true;
+
+    // OpenGL 2.1 has query objects, the elapsed time target comes with GL_ARB_timer_query
+    if (!SDL_GL_ExtensionSupported("GL_ARB_timer_query"))
+        return false;
+
+    glad_glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC) SDL_GL_GetProcAddress("glGetQueryObjectui64v");
+
+    return glad_glGenQueries && glad_glBeginQuery && glad_glGetQueryObjectui64v;
+#endif
+}
@@ -0,0 +1,92 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include "GL.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef RENDERER_GL_ES
+// OpenGL 4.1 / GL_ARB_get_program_binary, not part of the generated OpenGL 3.3 loader
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+
+typedef void (GLAD_API_PTR *PFNGLGETPROGRAMBINARYPROC)(GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary);
+typedef void (GLAD_API_PTR *PFNGLPROGRAMBINARYPROC)(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length);
+typedef void (GLAD_API_PTR *PFNGLPROGRAMPARAMETERIPROC)(GLuint program, GLenum pname, GLint value);
+
+extern PFNGLGETPROGRAMBINARYPROC glad_glGetProgramBinary;
+extern PFNGLPROGRAMBINARYPROC glad_glProgramBinary;
+extern PFNGLPROGRAMPARAMETERIPROC glad_glProgramParameteri;
+
+#define glGetProgramBinary glad_glGetProgramBinary
+#define glProgramBinary glad_glProgramBinary
+#define glProgramParameteri glad_glProgramParameteri
+#endif
+
+#ifndef GL_COMPRESSED_RGBA8_ETC2_EAC
+// Core in OpenGL ES 3.0, the desktop value is only needed to name the format
+#define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
+
+#ifndef RENDERER_GL_ES
+// OpenGL 2.1, left out of the core loader. gl_PointCoord of the particle point sprites needs it
+#define GL_POINT_SPRITE 0x8861
+#endif
+
+// GL_EXT_texture_compression_s3tc / WEBGL_compressed_texture_s3tc
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+
+#ifdef RENDERER_GL_ES
+// GL_EXT_disjoint_timer_query. The other query functions are core in OpenGL ES 3.0
+#define GL_TIME_ELAPSED 0x88BF
+#define GL_GPU_DISJOINT 0x8FBB
+
+typedef void (GLAD_API_PTR *PFNGLGETQUERYOBJECTUI64VPROC)(GLuint id, GLenum pname, GLuint64 *params);
+
+extern PFNGLGETQUERYOBJECTUI64VPROC glad_glGetQueryObjectui64v;
+
+#define glGetQueryObjectui64v glad_glGetQueryObjectui64v
+#endif
+
+// Optional features that are core in OpenGL 3.3 / OpenGL ES 3.0 but only extensions before,
+// and the compressed texture formats the GPU samples natively
+typedef struct GLExtensions
+{
+    bool vertexArrayObject;
+    bool programBinary;
+    bool textureETC2;
+    bool textureS3TC;
+    bool timerQuery;
+} GLExtensions;
+
+void GLExtensions_Load(GLExtensions *extensions);
+
+#ifdef __cplusplus
+}
+#endif
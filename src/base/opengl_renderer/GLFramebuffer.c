@@ -0,0 +1,131 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#include "GLFramebuffer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct GLFramebuffer
+{
+    GLState *state;
+    GLuint framebuffer;
+    GLuint depthBuffer;
+    Texture2D texture;
+};
+
+GLFramebuffer *GLFramebuffer_New(GLState *state, int width, int height)
+{
+    // Core since OpenGL 3.0 and OpenGL ES 2.0, glad leaves it NULL on older contexts
+    if (!glad_glGenFramebuffers)
+    {
+        puts("Framebuffer objects are not supported");
+        return NULL;
+    }
+
+    GLFramebuffer * const self = malloc(sizeof (GLFramebuffer));
+
+    self->state = state;
+    self->texture.width = width;
+    self->texture.height = height;
+#ifdef RENDERER_GL_ES
+    self->texture.format = RGBA;
+#endif
+
+    glGenTextures(1, &self->texture.id);
+    GLState_BindTexture(self->state, 0, self->texture.id);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    GLState_BindTexture(self->state, 0, 0);
+
+    glGenFramebuffers(1, &self->framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, self->framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, self->texture.id, 0);
+
+    // For the opaque pass of the renderer, 16 bits is enough and available everywhere
+    glGenRenderbuffers(1, &self->depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, self->depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT16, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, self->depthBuffer);
+
+    const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        printf("Framebuffer %dx%d is incomplete: 0x%x\n", width, height, status);
+        GLFramebuffer_Delete(self);
+        return NULL;
+    }
+
+    return self;
+}
+
+void GLFramebuffer_Delete(GLFramebuffer * const self)
+{
+    if (!self)
+        return;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &self->framebuffer);
+    glDeleteRenderbuffers(1, &self->depthBuffer);
+    GLState_DeleteTexture(self->state, self->texture.id);
+
+    free(self);
+}
+
+void GLFramebuffer_Bind(GLFramebuffer * const self)
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, self ? self->framebuffer : 0);
+}
+
+const Texture2D *GLFramebuffer_Texture(GLFramebuffer * const self)
+{
+    return &self->texture;
+}
+
+void GLFramebuffer_ReadPixels(int width, int height, uint8_t *pixels)
+{
+    const size_t pitch = width * 4;
+    uint8_t *row = malloc(pitch);
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+
+    // OpenGL starts at the bottom row
+    for (int y = 0; y < height / 2; ++y)
+    {
+        uint8_t *top = pixels + y * pitch;
+        uint8_t *bottom = pixels + (height - 1 - y) * pitch;
+
+        memcpy(row, top, pitch);
+        memcpy(top, bottom, pitch);
+        memcpy(bottom, row, pitch);
+    }
+
+    free(row);
+}
@@ -0,0 +1,53 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include "GL.h"
+#include "GLState.h"
+#include "GLTexture.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Offscreen render target with an RGBA8 color texture and a 16 bits depth buffer
+typedef struct GLFramebuffer GLFramebuffer;
+
+// NULL when framebuffer objects are not available (OpenGL 2.1 without 3.0) or incomplete
+GLFramebuffer *GLFramebuffer_New(GLState *state, int width, int height);
+void GLFramebuffer_Delete(GLFramebuffer * const self);
+
+// NULL binds the default framebuffer
+void GLFramebuffer_Bind(GLFramebuffer * const self);
+const Texture2D *GLFramebuffer_Texture(GLFramebuffer * const self);
+
+// Reads the bound framebuffer into width * height RGBA pixels, top row first
+void GLFramebuffer_ReadPixels(int width, int height, uint8_t *pixels);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,117 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#include "GLGpuTimer.h"
+
+#include <stdlib.h>
+
+#define GLGPUTIMER_QUERIES 4
+
+struct GLGpuTimer
+{
+    GLuint queries[GLGPUTIMER_QUERIES];
+
+    // Ring of queries: the next one to begin, and how many ended without being read
+    int next;
+    int pending;
+    bool running;
+};
+
+GLGpuTimer *GLGpuTimer_New(const GLExtensions *extensions)
+{
+    if (!extensions->timerQuery)
+        return NULL;
+
+    GLGpuTimer * const self = malloc(sizeof (GLGpuTimer));
+
+    glGenQueries(GLGPUTIMER_QUERIES, self->queries);
+    self->next = 0;
+    self->pending = 0;
+    self->running = false;
+
+    return self;
+}
+
+void GLGpuTimer_Delete(GLGpuTimer * const self)
+{
+    if (!self)
+        return;
+
+    glDeleteQueries(GLGPUTIMER_QUERIES, self->queries);
+    free(self);
+}
+
+void GLGpuTimer_Begin(GLGpuTimer * const self)
+{
+    if (self->running || self->pending == GLGPUTIMER_QUERIES)
+        return;
+
+    glBeginQuery(GL_TIME_ELAPSED, self->queries[self->next]);
+    self->running = true;
+}
+
+void GLGpuTimer_End(GLGpuTimer * const self)
+{
+    if (!self->running)
+        return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+    self->running = false;
+    self->next = (self->next + 1) % GLGPUTIMER_QUERIES;
+    self->pending++;
+}
+
+bool GLGpuTimer_Read(GLGpuTimer * const self, double *seconds)
+{
+    bool read = false;
+
+    while (self->pending > 0)
+    {
+        const GLuint query = self->queries[(self->next - self->pending + GLGPUTIMER_QUERIES) % GLGPUTIMER_QUERIES];
+        GLuint available = 0;
+
+        glGetQueryObjectuiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+
+        if (!available)
+            break;
+
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+
+        *seconds = (double) elapsed * 1e-9;
+        self->pending--;
+        read = true;
+    }
+
+#ifdef RENDERER_GL_ES
+    // A power state change or a context loss makes the results meaningless
+    GLint disjoint = 0;
+    glGetIntegerv(GL_GPU_DISJOINT, &disjoint);
+
+    if (disjoint)
+        return false;
+#endif
+
+    return read;
+}
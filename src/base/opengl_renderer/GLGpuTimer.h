@@ -0,0 +1,53 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include "GL.h"
+#include "GLExtensions.h"
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// GPU time of whole frames from GL_TIME_ELAPSED queries. Results are read a few frames late,
+// so asking for them never stalls the pipeline
+typedef struct GLGpuTimer GLGpuTimer;
+
+// NULL without timer queries
+GLGpuTimer *GLGpuTimer_New(const GLExtensions *extensions);
+void GLGpuTimer_Delete(GLGpuTimer * const self);
+
+// A frame is skipped while every query is still in flight
+void GLGpuTimer_Begin(GLGpuTimer * const self);
+void GLGpuTimer_End(GLGpuTimer * const self);
+
+// Seconds of the latest frame with a result, false if none arrived since the last call
+bool GLGpuTimer_Read(GLGpuTimer * const self, double *seconds);
+
+#ifdef __cplusplus
+}
+#endif
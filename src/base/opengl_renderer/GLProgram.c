@@ -23,28 +23,81 @@ SOFTWARE.
 -------------------------------------------------------------------------------*/
 
 #include "GLProgram.h"
+#include "GLProgramCache.h"
+#include "GLState.h"
+#include "GLUniformBuffer.h"
 
 #include <malloc.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+// Same attribute locations in every program, so the vertex state can be shared
+enum AttribLocation
+{
+    Location_Position = 0,
+    Location_UV = 1,
+    Location_Color = 2,
+    Location_Transform = 3,
+    Location_Translation = 4,
+    Location_Source = 5,
+    Location_Animation = 6,
+    Location_Slide = 7,
+    Location_Particle = 8,
+};
+
 struct GLProgram
 {
-    GLuint lastProgram;
+    GLState *state;
+    GLProgramCache *cache;
     GLProgramLocation programs[_Type_size];
 };
 
 static void CheckProgram(GLuint obj);
 static void CheckShader(GLuint obj);
-static GLuint CreateProgram(GLProgramLocation_Type type);
+static GLuint CreateProgram(GLProgram * const self, GLProgramLocation_Type type);
 static void CompileShader(GLuint program, GLenum type, const char *src);
 
-static char *GetShaderSource(GLProgramLocation_Type type, const char *source)
+// The shaders are written in GLSL ES 1.00. The uniform block needs GLSL 3.30 / GLSL ES 3.00,
+// so the modern programs get the few keywords that changed as macros
+static const char *ModernVertexPrologue =
+    "#define attribute in\n"
+    "#define varying out\n";
+
+static const char *ModernFragmentPrologue =
+    "#define varying in\n"
+    "#define texture2D texture\n"
+    "out mediump vec4 fragColor;\n";
+
+static const char *UniformBlock =
+    "layout(std140) uniform " GLUNIFORMBUFFER_BLOCK "\n"
+    "{\n"
+    "    highp mat4 uProjection;\n"
+    "    highp float uTime;\n"
+    "    highp float uPixelScale;\n"
+    "};\n";
+
+static char *GetShaderSource(GLProgramLocation_Type type, GLenum stage, const char *source)
 {
     char src[1024];
 
-    strcpy(src, "#version 100\n"); // OpenGL ES 2.0 / WebGL 1.0
+    if (IsModernOpenGL())
+    {
+#ifdef RENDERER_GL_ES
+        strcpy(src, "#version 300 es\n"); // OpenGL ES 3.0 / WebGL 2.0
+#else
+        strcpy(src, "#version 330 core\n");
+#endif
+        strcat(src, stage == GL_VERTEX_SHADER ? ModernVertexPrologue : ModernFragmentPrologue);
+        strcat(src, "#define hasUniformBuffer 1\n");
+        strcat(src, UniformBlock);
+    }
+    else
+    {
+        strcpy(src, "#version 100\n"); // OpenGL ES 2.0 / WebGL 1.0
+        strcat(src, "#define hasUniformBuffer 0\n");
+        strcat(src, "#define fragColor gl_FragColor\n");
+    }
 
     if (type == Type_Texture)
         strcat(src, "#define hasTexture 1\n");
@@ -53,6 +106,16 @@ static char *GetShaderSource(GLProgramLocation_Type type, const char *source)
     else
         strcat(src, "#define hasTexture 0\n");
 
+    if (type == Type_Shape)
+        strcat(src, "#define hasShape 1\n");
+    else
+        strcat(src, "#define hasShape 0\n");
+
+    if (IsModernOpenGL())
+        strcat(src, "#define isInstanced 1\n");
+    else
+        strcat(src, "#define isInstanced 0\n");
+
     int size = strlen(source) + strlen(src) + 1;
 
     char *buffer = malloc(size);
@@ -64,22 +127,25 @@ static char *GetShaderSource(GLProgramLocation_Type type, const char *source)
 static char *GetVertexShaderSource(GLProgramLocation_Type type)
 {
     #include "shaders/shader.vert.h"
+    #include "shaders/particle.vert.h"
 
-    return GetShaderSource(type, vert);
+    return GetShaderSource(type, GL_VERTEX_SHADER, type == Type_Particle ? particleVert : vert);
 }
 
 static char *GetFragmentShaderSource(GLProgramLocation_Type type)
 {
     #include "shaders/shader.frag.h"
+    #include "shaders/particle.frag.h"
 
-    return GetShaderSource(type, frag);
+    return GetShaderSource(type, GL_FRAGMENT_SHADER, type == Type_Particle ? particleFrag : frag);
 }
 
-GLProgram *GLProgram_New()
+GLProgram *GLProgram_New(GLState *state)
 {
     GLProgram * const self = malloc(sizeof (GLProgram));
 
-    self->lastProgram = 0;
+    self->state = state;
+    self->cache = GLProgramCache_New();
 
     return self;
 }
@@ -96,28 +162,47 @@ void GLProgram_Delete(GLProgram * const self)
         glDeleteProgram(program.program);
     }
 
+    GLProgramCache_Delete(self->cache);
+
     free(self);
 }
 
+void GLProgram_Init(GLProgram * const self, const GLExtensions *extensions)
+{
+    GLProgramCache_Init(self->cache, extensions);
+}
+
 const GLProgramLocation *GLProgram_InitProgram(GLProgram * const self, GLProgramLocation_Type type)
 {
-    GLuint program = CreateProgram(type);
+    GLuint program = CreateProgram(self, type);
+    GLState_UseProgram(self->state, program);
 
     self->programs[type] = (GLProgramLocation) {
+        .type = type,
         .program = program,
         .aPosition = glGetAttribLocation(program, "aPosition"),
         .aUV = -1,
         .aColor = -1,
+        .aTransform = -1,
+        .aTranslation = -1,
+        .aSource = -1,
+        .aAnimation = -1,
+        .aSlide = -1,
+        .aParticle = glGetAttribLocation(program, "aParticle"),
         .uProjection = glGetUniformLocation(program, "uProjection"),
+        .uTime = glGetUniformLocation(program, "uTime"),
         .uSampler = -1,
-        .uSourcePosition = -1,
+        .uSourcePosition = glGetUniformLocation(program, "uSourcePosition"),
         .uTransform = glGetUniformLocation(program, "uTransform"),
+        .uAnimation = glGetUniformLocation(program, "uAnimation"),
+        .uSlide = glGetUniformLocation(program, "uSlide"),
+        .uPixelScale = glGetUniformLocation(program, "uPixelScale"),
+        .uOverdraw = glGetUniformLocation(program, "uOverdraw"),
     };
 
     if (type == Type_Texture || type == Type_TextureBGRA)
     {
         self->programs[type].aUV = glGetAttribLocation(program, "aUV");
-        self->programs[type].uSourcePosition = glGetUniformLocation(program, "uSourcePosition");
         self->programs[type].uSampler = glGetUniformLocation(program, "uSampler");
     }
     else
@@ -125,6 +210,22 @@ const GLProgramLocation *GLProgram_InitProgram(GLProgram * const self, GLProgram
         self->programs[type].aColor = glGetAttribLocation(program, "aColor");
     }
 
+    if (IsModernOpenGL())
+    {
+        self->programs[type].aTransform = glGetAttribLocation(program, "aTransform");
+        self->programs[type].aTranslation = glGetAttribLocation(program, "aTranslation");
+        self->programs[type].aAnimation = glGetAttribLocation(program, "aAnimation");
+        self->programs[type].aSlide = glGetAttribLocation(program, "aSlide");
+        // The UV rect of the textures, the shape parameters of Type_Shape
+        self->programs[type].aSource = glGetAttribLocation(program, "aSource");
+
+        // Also for the programs loaded from the cache
+        const GLuint block = glGetUniformBlockIndex(program, GLUNIFORMBUFFER_BLOCK);
+
+        if (block != GL_INVALID_INDEX)
+            glUniformBlockBinding(program, block, GLUNIFORMBUFFER_BINDING);
+    }
+
     return &self->programs[type];
 }
 
@@ -132,31 +233,53 @@ const GLProgramLocation *GLProgram_GetProgram(GLProgram * const self, GLProgramL
 {
     const GLProgramLocation *program = &self->programs[type];
 
-    if (program->program != self->lastProgram)
-    {
-        glUseProgram(program->program);
-        self->lastProgram = program->program;
-    }
+    GLState_UseProgram(self->state, program->program);
 
     return program;
 }
 
-GLuint CreateProgram(GLProgramLocation_Type type)
+GLuint CreateProgram(GLProgram * const self, GLProgramLocation_Type type)
 {
-    GLuint program = glCreateProgram();
-
     char *vert = GetVertexShaderSource(type);
     char *frag = GetFragmentShaderSource(type);
 
+    GLuint program = GLProgramCache_Load(self->cache, type, vert, frag);
+
+    if (program)
+    {
+        free(vert);
+        free(frag);
+
+        return program;
+    }
+
+    program = glCreateProgram();
+
     CompileShader(program, GL_VERTEX_SHADER, vert);
     CompileShader(program, GL_FRAGMENT_SHADER, frag);
 
-    free(vert);
-    free(frag);
-
+    glBindAttribLocation(program, Location_Position, "aPosition");
+    glBindAttribLocation(program, Location_UV, "aUV");
+    glBindAttribLocation(program, Location_Color, "aColor");
+    glBindAttribLocation(program, Location_Transform, "aTransform");
+    glBindAttribLocation(program, Location_Translation, "aTranslation");
+    glBindAttribLocation(program, Location_Source, "aSource");
+    glBindAttribLocation(program, Location_Animation, "aAnimation");
+    glBindAttribLocation(program, Location_Slide, "aSlide");
+
+    // OpenGL 2.1 only draws when attribute 0 is an array, the point sprites have no aPosition to fill it.
+    // Location 8 is also past the 8 attributes OpenGL ES 2.0 guarantees
+    if (type == Type_Particle)
+        glBindAttribLocation(program, IsModernOpenGL() ? Location_Particle : Location_Position, "aParticle");
+
+    GLProgramCache_PrepareLink(self->cache, program);
     glLinkProgram(program);
     CheckProgram(program);
-    glUseProgram(program);
+
+    GLProgramCache_Store(self->cache, type, vert, frag, program);
+
+    free(vert);
+    free(frag);
 
     return program;
 }
@@ -37,26 +37,43 @@ typedef enum GLProgramLocation_Type
     Type_Color = 0,
     Type_Texture = 1,
     Type_TextureBGRA = 2,
-    _Type_size = 3
+    Type_Particle = 3,
+    Type_Shape = 4,
+    _Type_size = 5
 } GLProgramLocation_Type;
 
 typedef struct GLProgramLocation
 {
+    GLProgramLocation_Type type;
     GLuint program;
     GLint aPosition;
     GLint aUV;
     GLint aColor;
+    GLint aTransform;
+    GLint aTranslation;
+    GLint aSource;
+    GLint aAnimation;
+    GLint aSlide;
+    GLint aParticle;
     GLint uProjection;
+    GLint uTime;
     GLint uSampler;
     GLint uSourcePosition;
     GLint uTransform;
+    GLint uAnimation;
+    GLint uSlide;
+    GLint uPixelScale;
+    GLint uOverdraw;
 } GLProgramLocation;
 
+typedef struct GLExtensions GLExtensions;
+typedef struct GLState GLState;
 typedef struct GLProgram GLProgram;
 
-GLProgram *GLProgram_New();
+GLProgram *GLProgram_New(GLState *state);
 void GLProgram_Delete(GLProgram * const self);
 
+void GLProgram_Init(GLProgram * const self, const GLExtensions *extensions);
 const GLProgramLocation *GLProgram_InitProgram(GLProgram * const self, GLProgramLocation_Type type);
 const GLProgramLocation *GLProgram_GetProgram(GLProgram * const self, GLProgramLocation_Type type);
 
@@ -0,0 +1,219 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#include "GLProgramCache.h"
+#include "GLExtensions.h"
+
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL2/SDL_filesystem.h>
+#include <SDL2/SDL_rwops.h>
+
+#define CACHE_MAGIC 0x50545454 // "TTTP"
+#define CACHE_VERSION 1
+#define HASH_SEED 0xcbf29ce484222325ULL
+
+typedef struct CacheHeader
+{
+    Uint32 magic;
+    Uint32 version;
+    Uint64 driver; // vendor, renderer and version strings
+    Uint64 source; // vertex and fragment shader sources
+    Uint32 format;
+    Uint32 length;
+} CacheHeader;
+
+struct GLProgramCache
+{
+    bool enabled;
+    char *path;
+    Uint64 driver;
+};
+
+static Uint64 Hash(Uint64 hash, const char *str);
+static void GetFileName(GLProgramCache * const self, GLProgramLocation_Type type, char *filename, size_t size);
+
+GLProgramCache *GLProgramCache_New()
+{
+    GLProgramCache * const self = malloc(sizeof (GLProgramCache));
+
+    self->enabled = false;
+    self->path = NULL;
+    self->driver = 0;
+
+    return self;
+}
+
+void GLProgramCache_Delete(GLProgramCache * const self)
+{
+    if (!self)
+        return;
+
+    SDL_free(self->path);
+
+    free(self);
+}
+
+void GLProgramCache_Init(GLProgramCache * const self, const GLExtensions *extensions)
+{
+    if (!extensions->programBinary)
+        return;
+
+    self->path = SDL_GetPrefPath("fabiopichler", "Tic-Tac-Toe");
+
+    if (!self->path)
+    {
+        printf("GL program cache disabled: %s\n", SDL_GetError());
+        return;
+    }
+
+    // A driver update or another GPU makes the saved binaries useless, they are recompiled then
+    self->driver = Hash(HASH_SEED, (const char *) glGetString(GL_VENDOR));
+    self->driver = Hash(self->driver, (const char *) glGetString(GL_RENDERER));
+    self->driver = Hash(self->driver, (const char *) glGetString(GL_VERSION));
+    self->enabled = true;
+}
+
+GLuint GLProgramCache_Load(GLProgramCache * const self, GLProgramLocation_Type type, const char *vert, const char *frag)
+{
+    if (!self->enabled)
+        return 0;
+
+    char filename[1024];
+    GetFileName(self, type, filename, sizeof (filename));
+
+    SDL_RWops *file = SDL_RWFromFile(filename, "rb");
+
+    if (!file)
+        return 0;
+
+    CacheHeader header;
+    void *binary = NULL;
+
+    if (SDL_RWread(file, &header, sizeof (header), 1) == 1
+            && header.magic == CACHE_MAGIC
+            && header.version == CACHE_VERSION
+            && header.driver == self->driver
+            && header.source == Hash(Hash(HASH_SEED, vert), frag)
+            && header.length > 0)
+    {
+        binary = malloc(header.length);
+
+        if (SDL_RWread(file, binary, header.length, 1) != 1)
+        {
+            free(binary);
+            binary = NULL;
+        }
+    }
+
+    SDL_RWclose(file);
+
+    if (!binary)
+        return 0;
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, header.format, binary, header.length);
+    free(binary);
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+
+    if (status != GL_TRUE)
+    {
+        printf("GL program cache: %s rejected by the driver\n", filename);
+        glDeleteProgram(program);
+        return 0;
+    }
+
+    return program;
+}
+
+void GLProgramCache_PrepareLink(GLProgramCache * const self, GLuint program)
+{
+    // Only OpenGL ES 2.0 with GL_OES_get_program_binary lacks the hint, its binaries are always retrievable
+    if (self->enabled && glProgramParameteri)
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+void GLProgramCache_Store(GLProgramCache * const self, GLProgramLocation_Type type, const char *vert, const char *frag, GLuint program)
+{
+    if (!self->enabled)
+        return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+
+    if (length <= 0)
+        return;
+
+    void *binary = malloc(length);
+
+    GLsizei written = 0;
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &written, &format, binary);
+
+    const CacheHeader header = {
+        .magic = CACHE_MAGIC,
+        .version = CACHE_VERSION,
+        .driver = self->driver,
+        .source = Hash(Hash(HASH_SEED, vert), frag),
+        .format = format,
+        .length = written,
+    };
+
+    char filename[1024];
+    GetFileName(self, type, filename, sizeof (filename));
+
+    SDL_RWops *file = written > 0 ? SDL_RWFromFile(filename, "wb") : NULL;
+
+    if (file)
+    {
+        if (SDL_RWwrite(file, &header, sizeof (header), 1) != 1 || SDL_RWwrite(file, binary, written, 1) != 1)
+            printf("GL program cache: failed to write %s\n", filename);
+
+        SDL_RWclose(file);
+    }
+
+    free(binary);
+}
+
+Uint64 Hash(Uint64 hash, const char *str)
+{
+    // FNV-1a
+    for (const unsigned char *c = (const unsigned char *) str; c && *c; ++c)
+    {
+        hash ^= *c;
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+void GetFileName(GLProgramCache * const self, GLProgramLocation_Type type, char *filename, size_t size)
+{
+    snprintf(filename, size, "%sprogram_%d.bin", self->path, type);
+}
@@ -0,0 +1,50 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include "GLProgram.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct GLExtensions GLExtensions;
+
+// Linked program binaries saved in the SDL pref path, so later runs skip compiling the shaders
+typedef struct GLProgramCache GLProgramCache;
+
+GLProgramCache *GLProgramCache_New();
+void GLProgramCache_Delete(GLProgramCache * const self);
+
+void GLProgramCache_Init(GLProgramCache * const self, const GLExtensions *extensions);
+
+// Returns 0 when there is no usable binary, the caller then compiles from source
+GLuint GLProgramCache_Load(GLProgramCache * const self, GLProgramLocation_Type type, const char *vert, const char *frag);
+void GLProgramCache_PrepareLink(GLProgramCache * const self, GLuint program);
+void GLProgramCache_Store(GLProgramCache * const self, GLProgramLocation_Type type, const char *vert, const char *frag, GLuint program);
+
+#ifdef __cplusplus
+}
+#endif
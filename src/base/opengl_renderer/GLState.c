@@ -0,0 +1,430 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#include "GLState.h"
+
+#include <malloc.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MAX_VERTEX_ATTRIBS 16
+#define MAX_TEXTURE_UNITS 8
+#define MAX_UNIFORMS 64
+
+static const char *CounterNames[_Counter_size] = {
+    "programs",
+    "buffers",
+    "textures",
+    "vertex attribs",
+    "vertex arrays",
+    "blend",
+    "uniforms",
+    "depth",
+};
+
+typedef struct VertexAttribPointer
+{
+    bool valid;
+    GLuint buffer;
+    GLint size;
+    GLenum type;
+    GLboolean normalized;
+    GLsizei stride;
+    GLintptr offset;
+} VertexAttribPointer;
+
+typedef struct UniformValue
+{
+    GLuint program;
+    GLint location;
+    size_t size;
+    unsigned char data[sizeof (GLfloat) * 16];
+} UniformValue;
+
+struct GLState
+{
+    GLuint program;
+    GLuint arrayBuffer;
+    GLuint vertexArray;
+    GLuint activeUnit;
+    GLuint textures[MAX_TEXTURE_UNITS];
+
+    unsigned int enabledAttribs;
+    unsigned int pendingDisable;
+    VertexAttribPointer pointers[MAX_VERTEX_ATTRIBS];
+    GLuint divisors[MAX_VERTEX_ATTRIBS];
+
+    bool blend;
+    GLenum blendSrc;
+    GLenum blendDst;
+
+    bool depthTest;
+    bool depthMask;
+
+    int uniformsCount;
+    UniformValue uniforms[MAX_UNIFORMS];
+
+    GLStateCounter counters[_Counter_size];
+};
+
+static bool Changed(GLState * const self, GLStateCounter_Type type, bool changed);
+static bool UniformChanged(GLState * const self, GLint location, const void *data, size_t size);
+
+GLState *GLState_New()
+{
+    GLState * const self = malloc(sizeof (GLState));
+
+    // Defaults of a new context
+    self->program = 0;
+    self->arrayBuffer = 0;
+    self->vertexArray = 0;
+    self->activeUnit = 0;
+    self->enabledAttribs = 0;
+    self->pendingDisable = 0;
+    self->blend = false;
+    self->blendSrc = GL_ONE;
+    self->blendDst = GL_ZERO;
+    self->depthTest = false;
+    self->depthMask = true;
+    self->uniformsCount = 0;
+
+    for (int i = 0; i < MAX_TEXTURE_UNITS; ++i)
+        self->textures[i] = 0;
+
+    for (int i = 0; i < MAX_VERTEX_ATTRIBS; ++i)
+    {
+        self->pointers[i].valid = false;
+        self->divisors[i] = 0;
+    }
+
+    for (int i = 0; i < _Counter_size; ++i)
+        self->counters[i] = (GLStateCounter) {0, 0};
+
+    return self;
+}
+
+void GLState_Delete(GLState * const self)
+{
+    if (!self)
+        return;
+
+    free(self);
+}
+
+void GLState_UseProgram(GLState * const self, GLuint program)
+{
+    if (Changed(self, Counter_Program, self->program != program))
+    {
+        glUseProgram(program);
+        self->program = program;
+    }
+}
+
+void GLState_BindBuffer(GLState * const self, GLenum target, GLuint buffer)
+{
+    if (target != GL_ARRAY_BUFFER)
+    {
+        Changed(self, Counter_Buffer, true);
+        glBindBuffer(target, buffer);
+        return;
+    }
+
+    if (Changed(self, Counter_Buffer, self->arrayBuffer != buffer))
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        self->arrayBuffer = buffer;
+    }
+}
+
+void GLState_DeleteBuffer(GLState * const self, GLuint buffer)
+{
+    if (self->arrayBuffer == buffer)
+        self->arrayBuffer = 0;
+
+    for (int i = 0; i < MAX_VERTEX_ATTRIBS; ++i)
+        if (self->pointers[i].buffer == buffer)
+            self->pointers[i].valid = false;
+
+    glDeleteBuffers(1, &buffer);
+}
+
+void GLState_BindTexture(GLState * const self, GLuint unit, GLuint texture)
+{
+    if (!Changed(self, Counter_Texture, self->textures[unit] != texture))
+        return;
+
+    if (Changed(self, Counter_Texture, self->activeUnit != unit))
+    {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        self->activeUnit = unit;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+    self->textures[unit] = texture;
+}
+
+void GLState_DeleteTexture(GLState * const self, GLuint texture)
+{
+    // Deleting a bound texture reverts the binding to zero
+    for (int i = 0; i < MAX_TEXTURE_UNITS; ++i)
+        if (self->textures[i] == texture)
+            self->textures[i] = 0;
+
+    glDeleteTextures(1, &texture);
+}
+
+void GLState_BindVertexArray(GLState * const self, GLuint vertexArray)
+{
+    if (Changed(self, Counter_VertexArray, self->vertexArray != vertexArray))
+    {
+        glBindVertexArray(vertexArray);
+        self->vertexArray = vertexArray;
+    }
+}
+
+void GLState_DeleteVertexArray(GLState * const self, GLuint vertexArray)
+{
+    if (self->vertexArray == vertexArray)
+        self->vertexArray = 0;
+
+    glDeleteVertexArrays(1, &vertexArray);
+}
+
+void GLState_EnableVertexAttrib(GLState * const self, GLint location)
+{
+    const unsigned int bit = 1u << location;
+
+    if (self->pendingDisable & bit)
+    {
+        // The deferred disable and this enable cancel each other out
+        self->pendingDisable &= ~bit;
+        Changed(self, Counter_VertexAttrib, false);
+        Changed(self, Counter_VertexAttrib, false);
+    }
+    else if (Changed(self, Counter_VertexAttrib, !(self->enabledAttribs & bit)))
+    {
+        glEnableVertexAttribArray(location);
+        self->enabledAttribs |= bit;
+    }
+}
+
+void GLState_DisableVertexAttrib(GLState * const self, GLint location)
+{
+    const unsigned int bit = 1u << location;
+
+    // Deferred until the next draw, the next draw will often enable it again
+    if (self->enabledAttribs & bit)
+        self->pendingDisable |= bit;
+    else
+        Changed(self, Counter_VertexAttrib, false);
+}
+
+void GLState_VertexAttribPointer(GLState * const self, GLint location, GLint size, GLsizei stride, GLintptr offset)
+{
+    GLState_VertexAttribPointerType(self, location, size, GL_FLOAT, GL_FALSE, stride, offset);
+}
+
+void GLState_VertexAttribPointerType(GLState * const self, GLint location, GLint size, GLenum type, GLboolean normalized,
+                                     GLsizei stride, GLintptr offset)
+{
+    VertexAttribPointer * const pointer = &self->pointers[location];
+
+    const bool changed = !pointer->valid
+            || pointer->buffer != self->arrayBuffer
+            || pointer->size != size
+            || pointer->type != type
+            || pointer->normalized != normalized
+            || pointer->stride != stride
+            || pointer->offset != offset;
+
+    if (Changed(self, Counter_VertexAttrib, changed))
+    {
+        glVertexAttribPointer(location, size, type, normalized, stride, (void *) offset);
+        *pointer = (VertexAttribPointer) {true, self->arrayBuffer, size, type, normalized, stride, offset};
+    }
+}
+
+void GLState_VertexAttribDivisor(GLState * const self, GLint location, GLuint divisor)
+{
+    if (Changed(self, Counter_VertexAttrib, self->divisors[location] != divisor))
+    {
+        glVertexAttribDivisor(location, divisor);
+        self->divisors[location] = divisor;
+    }
+}
+
+void GLState_ApplyVertexAttribs(GLState * const self)
+{
+    for (int i = 0; self->pendingDisable; ++i)
+    {
+        const unsigned int bit = 1u << i;
+
+        if (self->pendingDisable & bit)
+        {
+            Changed(self, Counter_VertexAttrib, true);
+            glDisableVertexAttribArray(i);
+            self->enabledAttribs &= ~bit;
+            self->pendingDisable &= ~bit;
+        }
+    }
+}
+
+void GLState_SetBlend(GLState * const self, bool enabled)
+{
+    if (Changed(self, Counter_Blend, self->blend != enabled))
+    {
+        if (enabled)
+            glEnable(GL_BLEND);
+        else
+            glDisable(GL_BLEND);
+
+        self->blend = enabled;
+    }
+}
+
+void GLState_BlendFunc(GLState * const self, GLenum src, GLenum dst)
+{
+    if (Changed(self, Counter_Blend, self->blendSrc != src || self->blendDst != dst))
+    {
+        glBlendFunc(src, dst);
+        self->blendSrc = src;
+        self->blendDst = dst;
+    }
+}
+
+void GLState_SetDepthTest(GLState * const self, bool enabled)
+{
+    if (Changed(self, Counter_Depth, self->depthTest != enabled))
+    {
+        if (enabled)
+            glEnable(GL_DEPTH_TEST);
+        else
+            glDisable(GL_DEPTH_TEST);
+
+        self->depthTest = enabled;
+    }
+}
+
+void GLState_SetDepthMask(GLState * const self, bool enabled)
+{
+    if (Changed(self, Counter_Depth, self->depthMask != enabled))
+    {
+        glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+        self->depthMask = enabled;
+    }
+}
+
+void GLState_Uniform1i(GLState * const self, GLint location, GLint value)
+{
+    if (UniformChanged(self, location, &value, sizeof (value)))
+        glUniform1i(location, value);
+}
+
+void GLState_Uniform1f(GLState * const self, GLint location, GLfloat value)
+{
+    if (UniformChanged(self, location, &value, sizeof (value)))
+        glUniform1f(location, value);
+}
+
+void GLState_Uniform4f(GLState * const self, GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w)
+{
+    const GLfloat value[4] = {x, y, z, w};
+
+    if (UniformChanged(self, location, value, sizeof (value)))
+        glUniform4f(location, x, y, z, w);
+}
+
+void GLState_UniformMatrix3fv(GLState * const self, GLint location, const GLfloat *value)
+{
+    if (UniformChanged(self, location, value, sizeof (GLfloat) * 9))
+        glUniformMatrix3fv(location, 1, GL_FALSE, value);
+}
+
+void GLState_UniformMatrix4fv(GLState * const self, GLint location, const GLfloat *value)
+{
+    if (UniformChanged(self, location, value, sizeof (GLfloat) * 16))
+        glUniformMatrix4fv(location, 1, GL_FALSE, value);
+}
+
+const GLStateCounter *GLState_GetCounter(GLState * const self, GLStateCounter_Type type)
+{
+    return &self->counters[type];
+}
+
+void GLState_PrintCounters(GLState * const self)
+{
+    for (int i = 0; i < _Counter_size; ++i)
+    {
+        const GLStateCounter *counter = &self->counters[i];
+
+        printf("GL state cache, %s: %lu calls issued, %lu elided\n", CounterNames[i], counter->issued, counter->elided);
+    }
+}
+
+bool Changed(GLState * const self, GLStateCounter_Type type, bool changed)
+{
+    if (changed)
+        self->counters[type].issued++;
+    else
+        self->counters[type].elided++;
+
+    return changed;
+}
+
+bool UniformChanged(GLState * const self, GLint location, const void *data, size_t size)
+{
+    if (location == -1)
+        return false;
+
+    UniformValue *uniform = NULL;
+
+    for (int i = 0; i < self->uniformsCount; ++i)
+    {
+        if (self->uniforms[i].program == self->program && self->uniforms[i].location == location)
+        {
+            uniform = &self->uniforms[i];
+            break;
+        }
+    }
+
+    if (!uniform)
+    {
+        // Not cached when the table is full, the value is always sent
+        if (self->uniformsCount == MAX_UNIFORMS)
+            return Changed(self, Counter_Uniform, true);
+
+        uniform = &self->uniforms[self->uniformsCount++];
+        uniform->program = self->program;
+        uniform->location = location;
+        uniform->size = 0;
+    }
+
+    if (!Changed(self, Counter_Uniform, uniform->size != size || memcmp(uniform->data, data, size) != 0))
+        return false;
+
+    uniform->size = size;
+    memcpy(uniform->data, data, size);
+
+    return true;
+}
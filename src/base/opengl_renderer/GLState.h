@@ -0,0 +1,91 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include "GL.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum GLStateCounter_Type
+{
+    Counter_Program = 0,
+    Counter_Buffer = 1,
+    Counter_Texture = 2,
+    Counter_VertexAttrib = 3,
+    Counter_VertexArray = 4,
+    Counter_Blend = 5,
+    Counter_Uniform = 6,
+    Counter_Depth = 7,
+    _Counter_size = 8
+} GLStateCounter_Type;
+
+typedef struct GLStateCounter
+{
+    unsigned long issued;
+    unsigned long elided;
+} GLStateCounter;
+
+// Shadow copy of the GL state, so calls that would not change anything are never sent to the driver
+typedef struct GLState GLState;
+
+GLState *GLState_New();
+void GLState_Delete(GLState * const self);
+
+void GLState_UseProgram(GLState * const self, GLuint program);
+void GLState_BindBuffer(GLState * const self, GLenum target, GLuint buffer);
+void GLState_DeleteBuffer(GLState * const self, GLuint buffer);
+void GLState_BindTexture(GLState * const self, GLuint unit, GLuint texture);
+void GLState_DeleteTexture(GLState * const self, GLuint texture);
+
+void GLState_BindVertexArray(GLState * const self, GLuint vertexArray);
+void GLState_DeleteVertexArray(GLState * const self, GLuint vertexArray);
+
+void GLState_EnableVertexAttrib(GLState * const self, GLint location);
+void GLState_DisableVertexAttrib(GLState * const self, GLint location);
+void GLState_VertexAttribPointer(GLState * const self, GLint location, GLint size, GLsizei stride, GLintptr offset);
+void GLState_VertexAttribPointerType(GLState * const self, GLint location, GLint size, GLenum type, GLboolean normalized,
+                                     GLsizei stride, GLintptr offset);
+void GLState_VertexAttribDivisor(GLState * const self, GLint location, GLuint divisor);
+void GLState_ApplyVertexAttribs(GLState * const self);
+
+void GLState_SetBlend(GLState * const self, bool enabled);
+void GLState_BlendFunc(GLState * const self, GLenum src, GLenum dst);
+void GLState_SetDepthTest(GLState * const self, bool enabled);
+void GLState_SetDepthMask(GLState * const self, bool enabled);
+
+void GLState_Uniform1i(GLState * const self, GLint location, GLint value);
+void GLState_Uniform1f(GLState * const self, GLint location, GLfloat value);
+void GLState_Uniform4f(GLState * const self, GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w);
+void GLState_UniformMatrix3fv(GLState * const self, GLint location, const GLfloat *value);
+void GLState_UniformMatrix4fv(GLState * const self, GLint location, const GLfloat *value);
+
+const GLStateCounter *GLState_GetCounter(GLState * const self, GLStateCounter_Type type);
+void GLState_PrintCounters(GLState * const self);
+
+#ifdef __cplusplus
+}
+#endif
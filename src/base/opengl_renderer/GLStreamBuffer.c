@@ -0,0 +1,175 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#include "GLStreamBuffer.h"
+#include "GLState.h"
+
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SEGMENT_COUNT 4
+
+static const GLsizeiptr Alignment = 16;
+static const GLuint64 FenceTimeout = 1000000000; // 1 second
+
+struct GLStreamBuffer
+{
+    GLState *state;
+    GLuint id;
+    GLsizeiptr size;
+    GLsizeiptr segmentSize;
+    GLintptr offset;
+    int segment;
+    bool mapped;
+    GLsync fences[SEGMENT_COUNT];
+};
+
+static GLintptr Reserve(GLStreamBuffer * const self, GLsizeiptr size);
+static void EnterSegment(GLStreamBuffer * const self, int segment);
+
+GLStreamBuffer *GLStreamBuffer_New(GLState *state, GLsizeiptr size)
+{
+    GLStreamBuffer * const self = malloc(sizeof (GLStreamBuffer));
+
+    self->state = state;
+    self->id = 0;
+    self->size = size;
+    self->segmentSize = size / SEGMENT_COUNT;
+    self->offset = 0;
+    self->segment = 0;
+    self->mapped = false;
+
+    for (int i = 0; i < SEGMENT_COUNT; ++i)
+        self->fences[i] = NULL;
+
+    return self;
+}
+
+void GLStreamBuffer_Delete(GLStreamBuffer * const self)
+{
+    if (!self)
+        return;
+
+    for (int i = 0; i < SEGMENT_COUNT; ++i)
+        if (self->fences[i])
+            glDeleteSync(self->fences[i]);
+
+    GLState_DeleteBuffer(self->state, self->id);
+
+    free(self);
+}
+
+void GLStreamBuffer_Init(GLStreamBuffer * const self)
+{
+#ifndef __EMSCRIPTEN__
+    // WebGL has no buffer mapping, it always takes the orphaning path
+    self->mapped = IsModernOpenGL();
+#endif
+
+    glGenBuffers(1, &self->id);
+    GLState_BindBuffer(self->state, GL_ARRAY_BUFFER, self->id);
+    glBufferData(GL_ARRAY_BUFFER, self->size, NULL, GL_STREAM_DRAW);
+}
+
+GLintptr GLStreamBuffer_Upload(GLStreamBuffer * const self, const void *data, GLsizeiptr size)
+{
+    GLState_BindBuffer(self->state, GL_ARRAY_BUFFER, self->id);
+
+    const GLintptr offset = Reserve(self, size);
+
+    if (self->mapped)
+    {
+        void *ptr = glMapBufferRange(GL_ARRAY_BUFFER, offset, size,
+                                     GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+
+        if (ptr)
+        {
+            memcpy(ptr, data, size);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+        }
+        else
+        {
+            glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+        }
+    }
+    else
+    {
+        glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+    }
+
+    self->offset = offset + size;
+
+    return offset;
+}
+
+GLintptr Reserve(GLStreamBuffer * const self, GLsizeiptr size)
+{
+    GLintptr offset = (self->offset + Alignment - 1) & ~(Alignment - 1);
+
+    if (size > self->segmentSize)
+    {
+        printf("Stream buffer: %ld bytes do not fit in a %ld bytes segment\n", (long) size, (long) self->segmentSize);
+        exit(EXIT_FAILURE);
+    }
+
+    // A range never straddles two segments, so the fence of a segment covers every draw that used it
+    if (offset / self->segmentSize != (offset + size - 1) / self->segmentSize)
+        offset = (offset / self->segmentSize + 1) * self->segmentSize;
+
+    if (offset + size > self->size)
+    {
+        offset = 0;
+
+        // Without mapping, give the old storage to the driver and start over in a fresh one
+        if (!self->mapped)
+            glBufferData(GL_ARRAY_BUFFER, self->size, NULL, GL_STREAM_DRAW);
+    }
+
+    if (self->mapped)
+    {
+        const int segment = offset / self->segmentSize;
+
+        while (self->segment != segment)
+            EnterSegment(self, (self->segment + 1) % SEGMENT_COUNT);
+    }
+
+    return offset;
+}
+
+void EnterSegment(GLStreamBuffer * const self, int segment)
+{
+    self->fences[self->segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    self->segment = segment;
+
+    GLsync fence = self->fences[segment];
+
+    if (fence)
+    {
+        glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FenceTimeout);
+        glDeleteSync(fence);
+        self->fences[segment] = NULL;
+    }
+}
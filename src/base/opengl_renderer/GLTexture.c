@@ -23,23 +23,33 @@ SOFTWARE.
 -------------------------------------------------------------------------------*/
 
 #include "GLTexture.h"
+#include "GLExtensions.h"
+#include "GLState.h"
 
 #include <malloc.h>
 #include <stdlib.h>
 #include <stdio.h>
 
+static void Upload(GLTexture * const self, Texture2D *texture, const Image *image, TextureFilter filter);
 static void GetFormat(const Image *image, Texture2D *texture, int *mode, uint32_t *format);
-static void SetTextureFilter(TextureFilter filter);
+static bool UploadMipmaps(const Image *image, int mode, uint32_t format);
+static void SetTextureFilter(TextureFilter filter, bool hasMipmaps);
 
 struct GLTexture
 {
-
+    GLState *state;
+    bool formats[_ImageFormat_size];
 };
 
-GLTexture *GLTexture_New()
+GLTexture *GLTexture_New(GLState *state)
 {
     GLTexture * const self = malloc(sizeof (GLTexture));
 
+    self->state = state;
+
+    for (int i = 0; i < _ImageFormat_size; ++i)
+        self->formats[i] = i == ImageFormat_Pixels;
+
     return self;
 }
 
@@ -51,16 +61,48 @@ void GLTexture_Delete(GLTexture * const self)
     free(self);
 }
 
-void GLTexture_Init(GLTexture * const self)
+void GLTexture_Init(GLTexture * const self, const GLExtensions *extensions)
+{
+    self->formats[ImageFormat_ETC2] = extensions->textureETC2;
+    self->formats[ImageFormat_S3TC] = extensions->textureS3TC;
+}
+
+bool GLTexture_IsFormatSupported(GLTexture * const self, ImageFormat format)
 {
+    return format >= 0 && format < _ImageFormat_size && self->formats[format];
 }
 
 Texture2D *GLTexture_CreateTexture(GLTexture * const self, const Image *image, TextureFilter filter)
+{
+    Texture2D *texture = malloc(sizeof (Texture2D));
+
+    Upload(self, texture, image, filter);
+
+    return texture;
+}
+
+void GLTexture_UpdateTexture(GLTexture * const self, Texture2D *texture, const Image *image, TextureFilter filter)
+{
+    // A new name instead of respecifying the old one, draws still queued with it are not stalled
+    GLState_DeleteTexture(self->state, texture->id);
+
+    Upload(self, texture, image, filter);
+}
+
+void GLTexture_DestroyTexture(GLTexture * const self, Texture2D *texture)
+{
+    if (texture)
+    {
+        GLState_DeleteTexture(self->state, texture->id);
+        free(texture);
+    }
+}
+
+void Upload(GLTexture * const self, Texture2D *texture, const Image *image, TextureFilter filter)
 {
     int mode;
     uint32_t format;
-    const int rowLength = image->pitch / image->bytesPerPixel;
-    Texture2D *texture = malloc(sizeof (Texture2D));
+    const int rowLength = image->format == ImageFormat_Pixels ? image->pitch / image->bytesPerPixel : image->width;
 
     texture->width = image->width;
     texture->height = image->height;
@@ -69,12 +111,16 @@ Texture2D *GLTexture_CreateTexture(GLTexture * const self, const Image *image, T
 #endif
 
     glGenTextures(1, &texture->id);
-    glBindTexture(GL_TEXTURE_2D, texture->id);
+    GLState_BindTexture(self->state, 0, texture->id);
 
     GetFormat(image, texture, &mode, &format);
 
+    if (image->format != ImageFormat_Pixels)
+    {
+        glCompressedTexImage2D(GL_TEXTURE_2D, 0, mode, image->width, image->height, 0, image->size, image->pixels);
+    }
 #ifdef RENDERER_GL_ES
-    if (!IsOpenGL_ES_3())
+    else if (!IsOpenGL_ES_3())
     {
         if (rowLength != image->width)
         {
@@ -91,8 +137,8 @@ Texture2D *GLTexture_CreateTexture(GLTexture * const self, const Image *image, T
             glTexImage2D(GL_TEXTURE_2D, 0, mode, image->width, image->height, 0, format, GL_UNSIGNED_BYTE, image->pixels);
         }
     }
-    else
 #endif
+    else
     {
         if (rowLength != image->width)
             glPixelStorei(GL_UNPACK_ROW_LENGTH, rowLength);
@@ -102,34 +148,38 @@ Texture2D *GLTexture_CreateTexture(GLTexture * const self, const Image *image, T
         glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
     }
 
+    const bool hasMipmaps = filter == Mipmap && UploadMipmaps(image, mode, format);
+
+    // The driver can't build the chain of a compressed texture
+    if (filter == Mipmap && !hasMipmaps && image->format != ImageFormat_Pixels)
+        filter = Linear;
+
     if (glGetError() != GL_NO_ERROR)
     {
         puts("Texture error");
-        free(texture);
         exit(EXIT_FAILURE);
     }
 
-    SetTextureFilter(filter);
+    SetTextureFilter(filter, hasMipmaps);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    return texture;
+    GLState_BindTexture(self->state, 0, 0);
 }
 
-void GLTexture_DestroyTexture(GLTexture * const self, Texture2D *texture)
+void GetFormat(const Image *image, Texture2D *texture, int *mode, uint32_t *format)
 {
-    if (texture)
+    if (image->format == ImageFormat_ETC2)
     {
-        glDeleteTextures(1, &texture->id);
-        free(texture);
+        *mode = GL_COMPRESSED_RGBA8_ETC2_EAC;
+        *format = GL_RGBA;
     }
-}
-
-void GetFormat(const Image *image, Texture2D *texture, int *mode, uint32_t *format)
-{
-    if (image->bytesPerPixel == 4)
+    else if (image->format == ImageFormat_S3TC)
+    {
+        *mode = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        *format = GL_RGBA;
+    }
+    else if (image->bytesPerPixel == 4)
     {
         *mode = GL_RGBA;
         *format = GL_RGBA;
@@ -159,9 +209,38 @@ void GetFormat(const Image *image, Texture2D *texture, int *mode, uint32_t *form
     }
 }
 
-void SetTextureFilter(TextureFilter filter)
+bool UploadMipmaps(const Image *image, int mode, uint32_t format)
 {
-    if (filter == Linear)
+    if (image->mipmapsCount == 0)
+        return false;
+
+#ifdef RENDERER_GL_ES
+    // OpenGL ES 2.0 only samples mipmaps of power of two textures
+    if (!IsOpenGL_ES_3() && ((image->width & (image->width - 1)) || (image->height & (image->height - 1))))
+        return false;
+#endif
+
+    for (int i = 0; i < image->mipmapsCount; ++i)
+    {
+        const ImageLevel *level = &image->mipmaps[i];
+
+        if (image->format != ImageFormat_Pixels)
+            glCompressedTexImage2D(GL_TEXTURE_2D, i + 1, mode, level->width, level->height, 0, level->size, level->pixels);
+        else
+            glTexImage2D(GL_TEXTURE_2D, i + 1, mode, level->width, level->height, 0, format, GL_UNSIGNED_BYTE, level->pixels);
+    }
+
+    return true;
+}
+
+void SetTextureFilter(TextureFilter filter, bool hasMipmaps)
+{
+    if (hasMipmaps)
+    {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    }
+    else if (filter == Linear)
     {
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -27,6 +27,8 @@ SOFTWARE.
 #include "GL.h"
 #include "../TextureFilter.h"
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -49,24 +51,55 @@ typedef struct Texture2D
 #endif
 } Texture2D;
 
+#define IMAGE_MAX_MIPMAPS 15
+
+typedef enum ImageFormat
+{
+    ImageFormat_Pixels = 0,
+    ImageFormat_ETC2 = 1,
+    ImageFormat_S3TC = 2,
+    _ImageFormat_size = 3
+} ImageFormat;
+
+typedef struct ImageLevel
+{
+    int width;
+    int height;
+    size_t size;
+    const unsigned char *pixels;
+} ImageLevel;
+
 typedef struct Image
 {
+    // Compressed images are always RGBA, only width, height, size and pixels are used
+    ImageFormat format;
+    size_t size;
+
     int width;
     int height;
     int bytesPerPixel;
     int pitch;
     uint32_t rmask;
     unsigned char *pixels;
+
+    // Precomputed levels after the base one, tightly packed like it. Without them the GPU builds the chain
+    int mipmapsCount;
+    ImageLevel mipmaps[IMAGE_MAX_MIPMAPS];
 } Image;
 
+typedef struct GLState GLState;
+typedef struct GLExtensions GLExtensions;
 typedef struct GLTexture GLTexture;
 
-GLTexture *GLTexture_New();
+GLTexture *GLTexture_New(GLState *state);
 void GLTexture_Delete(GLTexture * const self);
 
-void GLTexture_Init(GLTexture * const self);
+void GLTexture_Init(GLTexture * const self, const GLExtensions *extensions);
+bool GLTexture_IsFormatSupported(GLTexture * const self, ImageFormat format);
 
 Texture2D *GLTexture_CreateTexture(GLTexture * const self, const Image *image, TextureFilter filter);
+// Replaces the pixels of an existing texture, everyone holding the Texture2D sees the new image
+void GLTexture_UpdateTexture(GLTexture * const self, Texture2D *texture, const Image *image, TextureFilter filter);
 void GLTexture_DestroyTexture(GLTexture * const self, Texture2D *texture);
 
 #ifdef __cplusplus
@@ -0,0 +1,109 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#include "GLUniformBuffer.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The std140 layout of the block declared by GetShaderSource in GLProgram.c
+typedef struct FrameBlock
+{
+    GLfloat projection[16];
+    GLfloat time;
+    GLfloat pixelScale;
+    GLfloat padding[2];
+} FrameBlock;
+
+struct GLUniformBuffer
+{
+    GLuint buffer;
+    FrameBlock block;
+    bool changed;
+};
+
+GLUniformBuffer *GLUniformBuffer_New(void)
+{
+    if (!IsModernOpenGL())
+        return NULL;
+
+    GLUniformBuffer * const self = malloc(sizeof (GLUniformBuffer));
+
+    memset(&self->block, 0, sizeof (FrameBlock));
+    self->changed = true;
+
+    glGenBuffers(1, &self->buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, self->buffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof (FrameBlock), NULL, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, GLUNIFORMBUFFER_BINDING, self->buffer);
+
+    return self;
+}
+
+void GLUniformBuffer_Delete(GLUniformBuffer * const self)
+{
+    if (!self)
+        return;
+
+    glDeleteBuffers(1, &self->buffer);
+    free(self);
+}
+
+void GLUniformBuffer_SetProjection(GLUniformBuffer * const self, mat4 projection)
+{
+    if (memcmp(self->block.projection, projection[0], sizeof (self->block.projection)) == 0)
+        return;
+
+    memcpy(self->block.projection, projection[0], sizeof (self->block.projection));
+    self->changed = true;
+}
+
+void GLUniformBuffer_SetTime(GLUniformBuffer * const self, float time)
+{
+    if (self->block.time == time)
+        return;
+
+    self->block.time = time;
+    self->changed = true;
+}
+
+void GLUniformBuffer_SetPixelScale(GLUniformBuffer * const self, float pixelScale)
+{
+    if (self->block.pixelScale == pixelScale)
+        return;
+
+    self->block.pixelScale = pixelScale;
+    self->changed = true;
+}
+
+void GLUniformBuffer_Upload(GLUniformBuffer * const self)
+{
+    if (!self->changed)
+        return;
+
+    glBindBuffer(GL_UNIFORM_BUFFER, self->buffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof (FrameBlock), &self->block);
+    self->changed = false;
+}
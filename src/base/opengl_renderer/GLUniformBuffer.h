@@ -0,0 +1,56 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include "GL.h"
+
+#include <cglm/mat4.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Binding point and name of the uniform block every program reads the frame constants from
+#define GLUNIFORMBUFFER_BINDING 0
+#define GLUNIFORMBUFFER_BLOCK "Frame"
+
+// The uniforms shared by every program, in one std140 block bound once. The values are kept here
+// and only the frames that change them upload the block
+typedef struct GLUniformBuffer GLUniformBuffer;
+
+// NULL before OpenGL 3.3 / OpenGL ES 3.0, the programs have their own uniforms then
+GLUniformBuffer *GLUniformBuffer_New(void);
+void GLUniformBuffer_Delete(GLUniformBuffer * const self);
+
+void GLUniformBuffer_SetProjection(GLUniformBuffer * const self, mat4 projection);
+void GLUniformBuffer_SetTime(GLUniformBuffer * const self, float time);
+void GLUniformBuffer_SetPixelScale(GLUniformBuffer * const self, float pixelScale);
+
+// Before a draw, sends the block if a value changed
+void GLUniformBuffer_Upload(GLUniformBuffer * const self);
+
+#ifdef __cplusplus
+}
+#endif
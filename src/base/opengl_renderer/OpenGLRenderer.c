@@ -24,8 +24,14 @@ SOFTWARE.
 
 #include "OpenGLRenderer.h"
 #include "GLBuffer.h"
+#include "GLExtensions.h"
+#include "GLGpuTimer.h"
 #include "GLProgram.h"
 #include "GLTexture.h"
+#include "GLState.h"
+#include "GLUniformBuffer.h"
+#include "../Animation.h"
+#include "../Vector.h"
 #include "../rect.h"
 
 #include <stdio.h>
@@ -41,28 +47,114 @@ SOFTWARE.
 
 #include <SDL2/SDL_video.h>
 
+// Every draw is a step nearer than the previous one, exact even in a 16 bits depth buffer
+static const int DepthSteps = 1 << 15;
+
+// What each shaded fragment adds in the overdraw view, 8 layers saturate
+static const float OverdrawStep = 1.0f / 8.0f;
+
+// Margin around shapes, in logical pixels, so the antialiased edge is not cut. The vertex shader adds the same
+static const float ShapePadding = 2.0f;
+
+// Consecutive instances of one program and texture
+typedef struct BatchCommand
+{
+    GLProgramLocation_Type type;
+    GLuint texture;
+    bool opaque;
+    int first;
+    int count;
+} BatchCommand;
+
+VECTOR_TYPE(Instances, Instance)
+VECTOR_TYPE(BatchCommands, BatchCommand)
+
+// Everything drawn since the last flush, in the order it was drawn
+typedef struct Batch
+{
+    Instances instances;
+    BatchCommands commands;
+    // Draws since the depth buffer was cleared
+    int depth;
+    Instance gathered[GLBUFFER_MAX_INSTANCES];
+} Batch;
+
 struct OpenGLRenderer
 {
+    GLState *state;
+    GLExtensions extensions;
     GLProgram *program;
     GLBuffer *buffer;
     GLTexture *texture;
+    GLFramebuffer *offscreen;
+    GLGpuTimer *gpuTimer;
+    // Projection, time and pixel scale of every program. NULL on OpenGL ES 2.0
+    GLUniformBuffer *uniformBuffer;
+
+    // At a render scale below 1 the scene is drawn into this framebuffer, then upscaled to the viewport
+    GLFramebuffer *scaled;
+    float renderScale;
+
     Vec2 viewport;
     Vec2 logical;
+    IRect viewportRect;
+    // Clock of the animations, uploaded as uTime
+    float time;
+    bool instanced;
+
+    bool windowDepth;
+    // Opaque draws go front to back with depth testing. Set at Clear when the target has a depth buffer
+    bool depthSorting;
+    bool overdraw;
+    // Every draw is opaque, for the upscale of the scene
+    bool forceOpaque;
+    Batch batch;
 };
 
-static void UpdateProjection(OpenGLRenderer * const self, GLint uProjection);
+static void UpdateProjection(OpenGLRenderer * const self);
+static void SetFrameUniforms(OpenGLRenderer * const self, const GLProgramLocation *program);
+static void UpdateScaledFramebuffer(OpenGLRenderer * const self);
 static void ColorToArray(const Color *color, vec4 array[4]);
+static float NextDepth(OpenGLRenderer * const self);
+static void PushInstance(OpenGLRenderer * const self, GLProgramLocation_Type type, GLuint texture, bool opaque, const Instance *instance);
+static bool IsOpaque(OpenGLRenderer * const self, GLProgramLocation_Type type, const Color *color);
+static void ClearDepth(OpenGLRenderer * const self);
+static void DrawOpaque(OpenGLRenderer * const self);
+static void DrawInOrder(OpenGLRenderer * const self);
+static void DrawGathered(OpenGLRenderer * const self, const BatchCommand *command, int count);
+static void DrawInstances(OpenGLRenderer * const self, GLProgramLocation_Type type, GLuint texture, const Instance *instances, int count);
+static void MatrixToInstance(mat3 matrix, Instance *instance);
+static void AnimationToArrays(const Animation *animation, vec4 animationArray, vec4 slide);
+static void DrawShape(OpenGLRenderer * const self, const Rect *rect, float angle, const vec4 shape, const Color *color, const Animation *animation);
+static void PushShapeInside(OpenGLRenderer * const self, const Rect *rect, float angle, const vec4 shape, const Color *color, const Instance *instance);
+static float PixelScale(OpenGLRenderer * const self);
 
 OpenGLRenderer *OpenGLRenderer_New()
 {
     OpenGLRenderer * const self = malloc(sizeof (OpenGLRenderer));
 
-    self->program = GLProgram_New();
-    self->buffer = GLBuffer_New();
-    self->texture = GLTexture_New();
+    self->state = GLState_New();
+    self->program = GLProgram_New(self->state);
+    self->buffer = GLBuffer_New(self->state);
+    self->texture = GLTexture_New(self->state);
+    self->offscreen = NULL;
+    self->gpuTimer = NULL;
+    self->uniformBuffer = NULL;
+    self->scaled = NULL;
+    self->renderScale = 1.0f;
 
     self->viewport = (Vec2) {0.0f, 0.0f};
     self->logical = (Vec2) {0.0f, 0.0f};
+    self->viewportRect = (IRect) {0, 0, 0, 0};
+    self->time = 0.0f;
+    self->instanced = false;
+    self->windowDepth = false;
+    self->depthSorting = false;
+    self->overdraw = false;
+    self->forceOpaque = false;
+    Instances_Init(&self->batch.instances);
+    BatchCommands_Init(&self->batch.commands);
+    self->batch.depth = 0;
 
     OpenGLRenderer_InitGL(self);
 
@@ -74,9 +166,18 @@ void OpenGLRenderer_Delete(OpenGLRenderer * const self)
     if (!self)
         return;
 
+    GLFramebuffer_Delete(self->scaled);
+    GLFramebuffer_Delete(self->offscreen);
+    GLGpuTimer_Delete(self->gpuTimer);
+    GLUniformBuffer_Delete(self->uniformBuffer);
     GLBuffer_Delete(self->buffer);
     GLProgram_Delete(self->program);
     GLTexture_Delete(self->texture);
+    Instances_Free(&self->batch.instances);
+    BatchCommands_Free(&self->batch.commands);
+
+    GLState_PrintCounters(self->state);
+    GLState_Delete(self->state);
 
     free(self);
 }
@@ -114,38 +215,170 @@ void OpenGLRenderer_InitGL(OpenGLRenderer * const self)
     printf("GL renderer: %s\n", glGetString(GL_RENDERER));
     printf("GL version: %s\n", glGetString(GL_VERSION));
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLExtensions_Load(&self->extensions);
+    self->instanced = IsModernOpenGL();
+
+    int depthSize = 0;
+    SDL_GL_GetAttribute(SDL_GL_DEPTH_SIZE, &depthSize);
+    self->windowDepth = depthSize > 0;
+
+    self->gpuTimer = GLGpuTimer_New(&self->extensions);
+
+    GLState_SetBlend(self->state, true);
+    GLState_BlendFunc(self->state, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     glEnable(GL_CULL_FACE);
     glCullFace(GL_BACK);
+
+#ifndef RENDERER_GL_ES
+    // The particles are point sprites before OpenGL 3.3, sized by the vertex shader
+    if (!self->instanced)
+    {
+        glEnable(GL_VERTEX_PROGRAM_POINT_SIZE);
+        glEnable(GL_POINT_SPRITE);
+    }
+#endif
+
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 
-    GLBuffer_Init(self->buffer);
-    GLTexture_Init(self->texture);
+    GLProgram_Init(self->program, &self->extensions);
+    GLBuffer_Init(self->buffer, &self->extensions);
+    GLTexture_Init(self->texture, &self->extensions);
+    self->uniformBuffer = GLUniformBuffer_New();
 
     for (size_t i = 0; i < _Type_size; ++i)
     {
         const GLProgramLocation *program = GLProgram_InitProgram(self->program, i);
-        UpdateProjection(self, program->uProjection);
+        GLBuffer_InitVertexArray(self->buffer, program);
     }
+
+    UpdateProjection(self);
 }
 
 Texture2D *OpenGLRenderer_CreateTexture(OpenGLRenderer * const self, const Image *image, TextureFilter filter)
 {
+    OpenGLRenderer_Flush(self);
+
     return GLTexture_CreateTexture(self->texture, image, filter);
 }
 
+void OpenGLRenderer_UpdateTexture(OpenGLRenderer * const self, Texture2D *texture, const Image *image, TextureFilter filter)
+{
+    OpenGLRenderer_Flush(self);
+    GLTexture_UpdateTexture(self->texture, texture, image, filter);
+}
+
+bool OpenGLRenderer_IsImageFormatSupported(OpenGLRenderer * const self, ImageFormat format)
+{
+    return GLTexture_IsFormatSupported(self->texture, format);
+}
+
 void OpenGLRenderer_DestroyTexture(OpenGLRenderer * const self, Texture2D *texture)
 {
+    OpenGLRenderer_Flush(self);
     GLTexture_DestroyTexture(self->texture, texture);
 }
 
 void OpenGLRenderer_Clear(OpenGLRenderer * const self)
 {
-    glClear(GL_COLOR_BUFFER_BIT);
+    Instances_Clear(&self->batch.instances);
+    BatchCommands_Clear(&self->batch.commands);
+
+    if (self->gpuTimer)
+        GLGpuTimer_Begin(self->gpuTimer);
+
+    if (self->scaled)
+    {
+        const Texture2D *texture = GLFramebuffer_Texture(self->scaled);
+
+        GLFramebuffer_Bind(self->scaled);
+        glViewport(0, 0, texture->width, texture->height);
+    }
+
+    // The framebuffers of the renderer always have a depth buffer, the window only if SDL got one
+    self->depthSorting = self->instanced && (self->scaled || self->offscreen || self->windowDepth);
+    self->batch.depth = 0;
+
+    if (self->depthSorting)
+    {
+        GLState_SetDepthMask(self->state, true);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    }
+    else
+    {
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
+}
+
+void OpenGLRenderer_EndFrame(OpenGLRenderer * const self)
+{
+    OpenGLRenderer_Flush(self);
+
+    if (self->scaled)
+    {
+        const Texture2D *texture = GLFramebuffer_Texture(self->scaled);
+
+        // Framebuffer textures start at the bottom row, so the source is flipped
+        const IRect srcrect = {0, texture->height, texture->width, -texture->height};
+        const Rect dstrect = {0.0f, 0.0f, self->logical.x, self->logical.y};
+
+        GLFramebuffer_Bind(self->offscreen);
+        glViewport(self->viewportRect.x, self->viewportRect.y, self->viewportRect.w, self->viewportRect.h);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        // The scene is opaque, blending would darken it by its own alpha. Nothing cleared the depth
+        // of this target, and the overdraw view was already drawn into the scene
+        const bool overdraw = self->overdraw;
+
+        self->depthSorting = false;
+        self->forceOpaque = true;
+        self->overdraw = false;
+
+        OpenGLRenderer_Draw(self, texture, &srcrect, &dstrect, 0.0f);
+        OpenGLRenderer_Flush(self);
+
+        self->forceOpaque = false;
+        self->overdraw = overdraw;
+    }
+
+    if (self->gpuTimer)
+        GLGpuTimer_End(self->gpuTimer);
+}
+
+void OpenGLRenderer_Flush(OpenGLRenderer * const self)
+{
+    Batch * const batch = &self->batch;
+
+    if (batch->commands.size == 0)
+        return;
+
+    if (self->depthSorting)
+    {
+        GLState_SetDepthTest(self->state, true);
+        GLState_SetDepthMask(self->state, true);
+        GLState_SetBlend(self->state, self->overdraw);
+        DrawOpaque(self);
+
+        // Translucent draws are hidden by nearer opaque ones, but don't hide anything themselves
+        GLState_SetDepthMask(self->state, false);
+        GLState_SetBlend(self->state, true);
+    }
+    else
+    {
+        GLState_SetDepthTest(self->state, false);
+    }
+
+    DrawInOrder(self);
+
+    Instances_Clear(&batch->instances);
+    BatchCommands_Clear(&batch->commands);
 }
 
 void OpenGLRenderer_Draw(OpenGLRenderer * const self, const Texture2D *texture, const IRect *srcrect, const Rect *dstrect, const float angle)
+{
+    OpenGLRenderer_DrawAnimated(self, texture, srcrect, dstrect, angle, NULL);
+}
+
+void OpenGLRenderer_DrawAnimated(OpenGLRenderer * const self, const Texture2D *texture, const IRect *srcrect, const Rect *dstrect, const float angle, const Animation *animation)
 {
     if (!texture)
         return;
@@ -169,24 +402,51 @@ void OpenGLRenderer_Draw(OpenGLRenderer * const self, const Texture2D *texture,
     glm_scale2d(matrix, (vec2) {dstrect->w, dstrect->h});
 
 #ifdef RENDERER_GL_ES
-    const GLProgramLocation *program = GLProgram_GetProgram(self->program,
-                                                            texture->format == BGRA ? Type_TextureBGRA : Type_Texture);
+    const GLProgramLocation_Type type = texture->format == BGRA ? Type_TextureBGRA : Type_Texture;
 #else
-    const GLProgramLocation *program = GLProgram_GetProgram(self->program, Type_Texture);
+    const GLProgramLocation_Type type = Type_Texture;
 #endif
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, texture->id);
+    if (self->instanced)
+    {
+        Instance instance = {.color = {0.0f, 0.0f, 0.0f, 0.0f}, .source = {0.0f, 0.0f, 1.0f, 1.0f}};
+        MatrixToInstance(matrix, &instance);
+        AnimationToArrays(animation, instance.animation, instance.slide);
+
+        if (srcrect)
+        {
+            instance.source[0] = srcrect->x / texture->width;
+            instance.source[1] = srcrect->y / texture->height;
+            instance.source[2] = srcrect->w / texture->width;
+            instance.source[3] = srcrect->h / texture->height;
+        }
+
+        instance.translation[2] = NextDepth(self);
+        PushInstance(self, type, texture->id, IsOpaque(self, type, NULL), &instance);
+        return;
+    }
+
+    const GLProgramLocation *program = GLProgram_GetProgram(self->program, type);
+
+    GLState_BindTexture(self->state, 0, texture->id);
 
     if (srcrect)
     {
-        glUniform4f(program->uSourcePosition,
-                    srcrect->x / texture->width, srcrect->y / texture->height,
-                    srcrect->w / texture->width, srcrect->h / texture->height);
+        GLState_Uniform4f(self->state, program->uSourcePosition,
+                          srcrect->x / texture->width, srcrect->y / texture->height,
+                          srcrect->w / texture->width, srcrect->h / texture->height);
     }
 
-    glUniformMatrix3fv(program->uTransform, 1, false, matrix[0]);
-    glUniform1i(program->uSampler, 0);
+    vec4 animationArray, slide;
+    AnimationToArrays(animation, animationArray, slide);
+
+    GLState_UniformMatrix3fv(self->state, program->uTransform, matrix[0]);
+    GLState_Uniform4f(self->state, program->uAnimation, animationArray[0], animationArray[1], animationArray[2], animationArray[3]);
+    GLState_Uniform4f(self->state, program->uSlide, slide[0], slide[1], slide[2], slide[3]);
+    SetFrameUniforms(self, program);
+    GLState_Uniform1f(self->state, program->uOverdraw, self->overdraw ? OverdrawStep : 0.0f);
+    GLState_Uniform1i(self->state, program->uSampler, 0);
+    GLState_SetBlend(self->state, !IsOpaque(self, type, NULL) || self->overdraw);
 
     GLBuffer_EnablePositionVBO(self->buffer, program);
     GLBuffer_DrawElements(self->buffer);
@@ -195,14 +455,49 @@ void OpenGLRenderer_Draw(OpenGLRenderer * const self, const Texture2D *texture,
 
 void OpenGLRenderer_FillRect(OpenGLRenderer * const self, const Rect *rect, const Color *color)
 {
+    OpenGLRenderer_FillRectAnimated(self, rect, color, NULL);
+}
+
+void OpenGLRenderer_FillRectAnimated(OpenGLRenderer * const self, const Rect *rect, const Color *color, const Animation *animation)
+{
+    // Blended rects are drawn as shapes with square corners, so they share a draw with the rounded
+    // ones around them. Opaque rects keep the plain program, which the opaque pass draws unblended
+    if (self->instanced && !IsOpaque(self, Type_Color, color))
+    {
+        DrawShape(self, rect, 0.0f, (vec4) {rect->w, rect->h, 0.0f, 0.0f}, color, animation);
+        return;
+    }
+
     mat3 matrix;
     glm_mat3_identity(matrix);
     glm_translate2d(matrix, (vec2) {rect->x, rect->y});
     glm_scale2d(matrix, (vec2) {rect->w, rect->h});
 
+    if (self->instanced)
+    {
+        Instance instance = {
+            .color = {color->r, color->g, color->b, color->a},
+            .source = {0.0f, 0.0f, 0.0f, 0.0f},
+        };
+        MatrixToInstance(matrix, &instance);
+        AnimationToArrays(animation, instance.animation, instance.slide);
+
+        instance.translation[2] = NextDepth(self);
+        PushInstance(self, Type_Color, 0, IsOpaque(self, Type_Color, color), &instance);
+        return;
+    }
+
     const GLProgramLocation *program = GLProgram_GetProgram(self->program, Type_Color);
 
-    glUniformMatrix3fv(program->uTransform, 1, false, matrix[0]);
+    vec4 animationArray, slide;
+    AnimationToArrays(animation, animationArray, slide);
+
+    GLState_UniformMatrix3fv(self->state, program->uTransform, matrix[0]);
+    GLState_Uniform4f(self->state, program->uAnimation, animationArray[0], animationArray[1], animationArray[2], animationArray[3]);
+    GLState_Uniform4f(self->state, program->uSlide, slide[0], slide[1], slide[2], slide[3]);
+    SetFrameUniforms(self, program);
+    GLState_Uniform1f(self->state, program->uOverdraw, self->overdraw ? OverdrawStep : 0.0f);
+    GLState_SetBlend(self->state, !IsOpaque(self, Type_Color, color) || self->overdraw);
 
     vec4 colorArray[4];
     ColorToArray(color, colorArray);
@@ -216,8 +511,165 @@ void OpenGLRenderer_FillRect(OpenGLRenderer * const self, const Rect *rect, cons
     GLBuffer_DisablePositionVBO(self->buffer, program);
 }
 
+void OpenGLRenderer_DrawRoundedRect(OpenGLRenderer * const self, const Rect *rect, float radius, float thickness, const Color *color, const Animation *animation)
+{
+    // The corners can't be rounder than half the smallest side
+    const float maxRadius = fminf(rect->w, rect->h) / 2.0f;
+
+    DrawShape(self, rect, 0.0f, (vec4) {rect->w, rect->h, fminf(radius, maxRadius), thickness}, color, animation);
+}
+
+void OpenGLRenderer_DrawCircle(OpenGLRenderer * const self, float x, float y, float radius, float thickness, const Color *color)
+{
+    const Rect rect = {x - radius, y - radius, radius * 2.0f, radius * 2.0f};
+
+    DrawShape(self, &rect, 0.0f, (vec4) {rect.w, rect.h, radius, thickness}, color, NULL);
+}
+
+void OpenGLRenderer_DrawLine(OpenGLRenderer * const self, float x1, float y1, float x2, float y2, float thickness, const Color *color)
+{
+    // A rounded rect as long as the line plus the caps, turned around its center
+    const float length = hypotf(x2 - x1, y2 - y1) + thickness;
+    const Rect rect = {(x1 + x2 - length) / 2.0f, (y1 + y2 - thickness) / 2.0f, length, thickness};
+
+    DrawShape(self, &rect, atan2f(y2 - y1, x2 - x1), (vec4) {length, thickness, thickness / 2.0f, 0.0f}, color, NULL);
+}
+
+void OpenGLRenderer_DrawParticles(OpenGLRenderer * const self, const ParticleVertex *particles, int count)
+{
+    OpenGLRenderer_Flush(self);
+
+    const GLProgramLocation *program = GLProgram_GetProgram(self->program, Type_Particle);
+
+    SetFrameUniforms(self, program);
+    GLState_Uniform1f(self->state, program->uOverdraw, self->overdraw ? OverdrawStep : 0.0f);
+
+    // Drawn after everything before them and always translucent
+    GLState_SetDepthTest(self->state, false);
+    GLState_SetBlend(self->state, true);
+
+    for (int first = 0; first < count; first += GLBUFFER_MAX_PARTICLES)
+    {
+        const int chunk = count - first < GLBUFFER_MAX_PARTICLES ? count - first : GLBUFFER_MAX_PARTICLES;
+
+        GLBuffer_EnablePositionVBO(self->buffer, program);
+        GLBuffer_EnableParticleVBO(self->buffer, program, particles + first, chunk);
+
+        GLBuffer_DrawParticles(self->buffer, chunk);
+
+        GLBuffer_DisableParticleVBO(self->buffer, program);
+        GLBuffer_DisablePositionVBO(self->buffer, program);
+    }
+}
+
+void OpenGLRenderer_Finish(OpenGLRenderer * const self)
+{
+    OpenGLRenderer_Flush(self);
+    glFinish();
+}
+
+void OpenGLRenderer_SetTime(OpenGLRenderer * const self, double seconds)
+{
+    OpenGLRenderer_Flush(self);
+
+    self->time = seconds;
+}
+
+double OpenGLRenderer_Time(OpenGLRenderer * const self)
+{
+    return self->time;
+}
+
+void OpenGLRenderer_SetRenderScale(OpenGLRenderer * const self, float scale)
+{
+    scale = fminf(fmaxf(scale, 0.25f), 1.0f);
+
+    if (scale == self->renderScale)
+        return;
+
+    OpenGLRenderer_Flush(self);
+
+    self->renderScale = scale;
+    UpdateScaledFramebuffer(self);
+}
+
+float OpenGLRenderer_RenderScale(OpenGLRenderer * const self)
+{
+    return self->renderScale;
+}
+
+void OpenGLRenderer_SetOverdrawView(OpenGLRenderer * const self, bool enabled)
+{
+    if (self->overdraw == enabled)
+        return;
+
+    OpenGLRenderer_Flush(self);
+    self->overdraw = enabled;
+
+    if (enabled)
+        GLState_BlendFunc(self->state, GL_ONE, GL_ONE);
+    else
+        GLState_BlendFunc(self->state, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+bool OpenGLRenderer_IsOverdrawView(OpenGLRenderer * const self)
+{
+    return self->overdraw;
+}
+
+bool OpenGLRenderer_IsGpuTimerSupported(OpenGLRenderer * const self)
+{
+    return self->gpuTimer != NULL;
+}
+
+bool OpenGLRenderer_GpuFrameTime(OpenGLRenderer * const self, double *seconds)
+{
+    return self->gpuTimer && GLGpuTimer_Read(self->gpuTimer, seconds);
+}
+
+bool OpenGLRenderer_SetOffscreen(OpenGLRenderer * const self, int width, int height)
+{
+    OpenGLRenderer_Flush(self);
+
+    GLFramebuffer_Delete(self->offscreen);
+    self->offscreen = NULL;
+
+    if (width > 0 && height > 0)
+        self->offscreen = GLFramebuffer_New(self->state, width, height);
+
+    GLFramebuffer_Bind(self->offscreen);
+
+    return self->offscreen || width <= 0 || height <= 0;
+}
+
+uint8_t *OpenGLRenderer_ReadPixels(OpenGLRenderer * const self, int *width, int *height)
+{
+    OpenGLRenderer_Flush(self);
+
+    if (self->offscreen)
+    {
+        const Texture2D *texture = GLFramebuffer_Texture(self->offscreen);
+
+        *width = texture->width;
+        *height = texture->height;
+    }
+    else
+    {
+        *width = self->viewport.x;
+        *height = self->viewport.y;
+    }
+
+    uint8_t *pixels = malloc(*width * *height * 4);
+
+    GLFramebuffer_ReadPixels(*width, *height, pixels);
+
+    return pixels;
+}
+
 void OpenGLRenderer_SetViewportSize(OpenGLRenderer * const self, int w, int h)
 {
+    OpenGLRenderer_Flush(self);
+
     self->viewport.x = w;
     self->viewport.y = h;
 
@@ -242,28 +694,81 @@ void OpenGLRenderer_SetViewportSize(OpenGLRenderer * const self, int w, int h)
         new_x = (self->viewport.x - new_w) / 2;
     }
 
+    self->viewportRect = (IRect) {new_x, new_y, new_w, new_h};
     glViewport(new_x, new_y, new_w, new_h);
+
+    UpdateScaledFramebuffer(self);
 }
 
 void OpenGLRenderer_SetLogicalSize(OpenGLRenderer * const self, int w, int h)
 {
+    OpenGLRenderer_Flush(self);
+
     self->logical.x = w;
     self->logical.y = h;
 
+    UpdateProjection(self);
+}
+
+// The depth is written by the vertex shader, so the projection only maps the logical size to clip space
+void UpdateProjection(OpenGLRenderer * const self)
+{
+    mat4 projection;
+
+    glm_ortho(0.0f, self->logical.x, self->logical.y, 0.0f, -1.0f, 1.0f, projection);
+
+    if (self->uniformBuffer)
+    {
+        GLUniformBuffer_SetProjection(self->uniformBuffer, projection);
+        return;
+    }
+
     for (size_t i = 0; i < _Type_size; ++i)
-        UpdateProjection(self, GLProgram_GetProgram(self->program, i)->uProjection);
+        GLState_UniformMatrix4fv(self->state, GLProgram_GetProgram(self->program, i)->uProjection, projection[0]);
+}
+
+// A single upload shared by every program with the uniform buffer, the uniforms of this program without it
+void SetFrameUniforms(OpenGLRenderer * const self, const GLProgramLocation *program)
+{
+    if (self->uniformBuffer)
+    {
+        GLUniformBuffer_SetTime(self->uniformBuffer, self->time);
+        GLUniformBuffer_SetPixelScale(self->uniformBuffer, PixelScale(self));
+        GLUniformBuffer_Upload(self->uniformBuffer);
+        return;
+    }
+
+    GLState_Uniform1f(self->state, program->uTime, self->time);
+    GLState_Uniform1f(self->state, program->uPixelScale, PixelScale(self));
 }
 
-void UpdateProjection(OpenGLRenderer * const self, GLint uProjection)
+void UpdateScaledFramebuffer(OpenGLRenderer * const self)
 {
-    mat4 proj, view, model, mvp;
+    const int width = ceilf(self->viewportRect.w * self->renderScale);
+    const int height = ceilf(self->viewportRect.h * self->renderScale);
+
+    if (self->scaled)
+    {
+        const Texture2D *texture = GLFramebuffer_Texture(self->scaled);
+
+        if (self->renderScale < 1.0f && texture->width == width && texture->height == height)
+            return;
+
+        GLFramebuffer_Delete(self->scaled);
+        self->scaled = NULL;
+    }
 
-    glm_ortho(0.0f, self->logical.x, self->logical.y, 0.0f, -1.0f, 1.0f, proj);
-    glm_lookat((vec3) {0.0f, 0.0f, 1.0f}, (vec3) {0.0f, 0.0f, 0.0f}, (vec3) {0.0f, 1.0f, 0.0f}, view);
-    glm_mat4_identity(model);
-    glm_mat4_mulN((mat4 *[]) {&proj, &view, &model}, 3, mvp);
+    if (self->renderScale < 1.0f && width > 0 && height > 0)
+    {
+        self->scaled = GLFramebuffer_New(self->state, width, height);
 
-    glUniformMatrix4fv(uProjection, 1, GL_FALSE, mvp[0]);
+        // Without framebuffer objects the scene is drawn at full resolution
+        if (!self->scaled)
+            self->renderScale = 1.0f;
+    }
+
+    // Between frames the window, or the offscreen target, stays bound
+    GLFramebuffer_Bind(self->offscreen);
 }
 
 void ColorToArray(const Color *color, vec4 array[4])
@@ -277,3 +782,290 @@ void ColorToArray(const Color *color, vec4 array[4])
 
     memcpy(array, _array, sizeof (vec4[4]));
 }
+
+// The depth of the next draw, from 1 at the far plane towards -1 at the near one
+float NextDepth(OpenGLRenderer * const self)
+{
+    Batch * const batch = &self->batch;
+
+    if (batch->depth == DepthSteps - 1)
+    {
+        // Out of steps, what was drawn so far is flushed and the depth starts over
+        OpenGLRenderer_Flush(self);
+        ClearDepth(self);
+    }
+
+    return 1.0f - 2.0f * ++batch->depth / DepthSteps;
+}
+
+void PushInstance(OpenGLRenderer * const self, GLProgramLocation_Type type, GLuint texture, bool opaque, const Instance *instance)
+{
+    Batch * const batch = &self->batch;
+    BatchCommand *command = batch->commands.size > 0 ? &batch->commands.data[batch->commands.size - 1] : NULL;
+
+    if (!command || command->type != type || command->texture != texture || command->opaque != opaque)
+    {
+        command = BatchCommands_Push(&batch->commands);
+        *command = (BatchCommand) {type, texture, opaque, batch->instances.size, 0};
+    }
+
+    *Instances_Push(&batch->instances) = *instance;
+    command->count++;
+}
+
+// Opaque draws cover whatever is behind them, so they need no blending and can go in the front to back pass
+bool IsOpaque(OpenGLRenderer * const self, GLProgramLocation_Type type, const Color *color)
+{
+    return self->forceOpaque || (type == Type_Color && color->a >= 255);
+}
+
+void ClearDepth(OpenGLRenderer * const self)
+{
+    self->batch.depth = 0;
+
+    if (!self->depthSorting)
+        return;
+
+    GLState_SetDepthMask(self->state, true);
+    glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+// Front to back, so the depth test rejects covered pixels before they are shaded. Apart from that the order
+// of opaque draws doesn't matter, all of one program and texture are gathered in the same draw calls
+void DrawOpaque(OpenGLRenderer * const self)
+{
+    Batch * const batch = &self->batch;
+
+    for (int i = batch->commands.size - 1; i >= 0; --i)
+    {
+        const BatchCommand key = batch->commands.data[i];
+        int count = 0;
+
+        if (!key.opaque || key.count == 0)
+            continue;
+
+        for (int j = i; j >= 0; --j)
+        {
+            BatchCommand * const command = &batch->commands.data[j];
+
+            if (!command->opaque || command->type != key.type || command->texture != key.texture)
+                continue;
+
+            for (int k = command->first + command->count - 1; k >= command->first; --k)
+            {
+                batch->gathered[count++] = batch->instances.data[k];
+
+                if (count == GLBUFFER_MAX_INSTANCES)
+                {
+                    DrawInstances(self, key.type, key.texture, batch->gathered, count);
+                    count = 0;
+                }
+            }
+
+            // Drawn, the next keys skip it
+            command->count = 0;
+        }
+
+        if (count > 0)
+            DrawInstances(self, key.type, key.texture, batch->gathered, count);
+    }
+}
+
+// Without depth sorting this is every draw, with blending only for the translucent ones.
+// With it, the opaque draws are already done and their commands are empty. The draws on both sides of
+// an empty command are still gathered in the same draw calls
+void DrawInOrder(OpenGLRenderer * const self)
+{
+    Batch * const batch = &self->batch;
+    const BatchCommand *run = NULL;
+    int count = 0;
+
+    for (size_t i = 0; i < batch->commands.size; ++i)
+    {
+        const BatchCommand *command = &batch->commands.data[i];
+
+        if (command->count == 0)
+            continue;
+
+        if (run && (command->type != run->type || command->texture != run->texture || command->opaque != run->opaque))
+        {
+            DrawGathered(self, run, count);
+            count = 0;
+        }
+
+        run = command;
+
+        for (int first = 0; first < command->count;)
+        {
+            const int size = command->count - first < GLBUFFER_MAX_INSTANCES - count ? command->count - first : GLBUFFER_MAX_INSTANCES - count;
+
+            memcpy(&batch->gathered[count], &batch->instances.data[command->first + first], size * sizeof (Instance));
+            count += size;
+            first += size;
+
+            if (count == GLBUFFER_MAX_INSTANCES)
+            {
+                DrawGathered(self, run, count);
+                count = 0;
+            }
+        }
+    }
+
+    if (count > 0)
+        DrawGathered(self, run, count);
+}
+
+void DrawGathered(OpenGLRenderer * const self, const BatchCommand *command, int count)
+{
+    if (!self->depthSorting)
+        GLState_SetBlend(self->state, !command->opaque || self->overdraw);
+
+    DrawInstances(self, command->type, command->texture, self->batch.gathered, count);
+}
+
+void DrawInstances(OpenGLRenderer * const self, GLProgramLocation_Type type, GLuint texture, const Instance *instances, int count)
+{
+    const GLProgramLocation *program = GLProgram_GetProgram(self->program, type);
+
+    if (type == Type_Texture || type == Type_TextureBGRA)
+    {
+        GLState_BindTexture(self->state, 0, texture);
+        GLState_Uniform1i(self->state, program->uSampler, 0);
+    }
+
+    SetFrameUniforms(self, program);
+    GLState_Uniform1f(self->state, program->uOverdraw, self->overdraw ? OverdrawStep : 0.0f);
+
+    GLBuffer_EnablePositionVBO(self->buffer, program);
+    GLBuffer_EnableInstanceVBO(self->buffer, program, instances, count);
+
+    GLBuffer_DrawElementsInstanced(self->buffer, count);
+
+    GLBuffer_DisableInstanceVBO(self->buffer, program);
+    GLBuffer_DisablePositionVBO(self->buffer, program);
+}
+void MatrixToInstance(mat3 matrix, Instance *instance)
+{
+    instance->transform[0] = matrix[0][0];
+    instance->transform[1] = matrix[0][1];
+    instance->transform[2] = matrix[1][0];
+    instance->transform[3] = matrix[1][1];
+    instance->translation[0] = matrix[2][0];
+    instance->translation[1] = matrix[2][1];
+}
+
+void AnimationToArrays(const Animation *animation, vec4 animationArray, vec4 slide)
+{
+    if (!animation)
+    {
+        glm_vec4_zero(animationArray);
+        glm_vec4_zero(slide);
+        return;
+    }
+
+    animationArray[0] = animation->startTime;
+    animationArray[1] = animation->angularVelocity;
+    animationArray[2] = animation->pulseAmplitude;
+    animationArray[3] = animation->pulseFrequency;
+    slide[0] = animation->slideX;
+    slide[1] = animation->slideY;
+    slide[2] = animation->slideDuration;
+    slide[3] = animation->slideEasing;
+}
+
+void DrawShape(OpenGLRenderer * const self, const Rect *rect, float angle, const vec4 shape, const Color *color, const Animation *animation)
+{
+    mat3 matrix;
+    glm_mat3_identity(matrix);
+    glm_translate2d(matrix, (vec2) {rect->x + rect->w / 2.0f, rect->y + rect->h / 2.0f});
+
+    if (angle != 0.0f)
+        glm_rotate2d(matrix, angle);
+
+    glm_scale2d(matrix, (vec2) {rect->w + ShapePadding * 2.0f, rect->h + ShapePadding * 2.0f});
+    glm_translate2d(matrix, (vec2) {-0.5f, -0.5f});
+
+    if (self->instanced)
+    {
+        Instance instance = {
+            .color = {color->r, color->g, color->b, color->a},
+            .source = {shape[0], shape[1], shape[2], shape[3]},
+        };
+        MatrixToInstance(matrix, &instance);
+        AnimationToArrays(animation, instance.animation, instance.slide);
+        instance.translation[2] = NextDepth(self);
+
+        if (self->depthSorting && color->a >= 255 && shape[3] == 0.0f)
+            PushShapeInside(self, rect, angle, shape, color, &instance);
+
+        PushInstance(self, Type_Shape, 0, IsOpaque(self, Type_Shape, color), &instance);
+        return;
+    }
+
+    const GLProgramLocation *program = GLProgram_GetProgram(self->program, Type_Shape);
+
+    vec4 animationArray, slide;
+    AnimationToArrays(animation, animationArray, slide);
+
+    GLState_UniformMatrix3fv(self->state, program->uTransform, matrix[0]);
+    GLState_Uniform4f(self->state, program->uAnimation, animationArray[0], animationArray[1], animationArray[2], animationArray[3]);
+    GLState_Uniform4f(self->state, program->uSlide, slide[0], slide[1], slide[2], slide[3]);
+    GLState_Uniform4f(self->state, program->uSourcePosition, shape[0], shape[1], shape[2], shape[3]);
+    SetFrameUniforms(self, program);
+    GLState_Uniform1f(self->state, program->uOverdraw, self->overdraw ? OverdrawStep : 0.0f);
+    GLState_SetBlend(self->state, !IsOpaque(self, Type_Shape, color) || self->overdraw);
+
+    vec4 colorArray[4];
+    ColorToArray(color, colorArray);
+
+    GLBuffer_EnablePositionVBO(self->buffer, program);
+    GLBuffer_EnableColorVBO(self->buffer, program, colorArray);
+
+    GLBuffer_DrawElements(self->buffer);
+
+    GLBuffer_DisableColorVBO(self->buffer, program);
+    GLBuffer_DisablePositionVBO(self->buffer, program);
+}
+
+// Only the antialiased edge of a filled opaque shape needs blending. Its inside is also drawn as an opaque
+// quad at the same depth, so it hides what's behind in the opaque pass and the depth test then skips it
+// when the shape is drawn. The quad keeps its corners inside the rounded ones and a pixel from the edge
+void PushShapeInside(OpenGLRenderer * const self, const Rect *rect, float angle, const vec4 shape, const Color *color, const Instance *instance)
+{
+    const float pixelScale = PixelScale(self);
+
+    if (pixelScale <= 0.0f)
+        return;
+
+    const float inset = shape[2] * (1.0f - sqrtf(0.5f)) + 1.0f / pixelScale;
+    const float width = shape[0] - inset * 2.0f;
+    const float height = shape[1] - inset * 2.0f;
+
+    if (width <= 0.0f || height <= 0.0f)
+        return;
+
+    mat3 matrix;
+    glm_mat3_identity(matrix);
+    glm_translate2d(matrix, (vec2) {rect->x + rect->w / 2.0f, rect->y + rect->h / 2.0f});
+
+    if (angle != 0.0f)
+        glm_rotate2d(matrix, angle);
+
+    glm_scale2d(matrix, (vec2) {width, height});
+    glm_translate2d(matrix, (vec2) {-0.5f, -0.5f});
+
+    Instance inside = *instance;
+    glm_vec4_zero(inside.source);
+    MatrixToInstance(matrix, &inside);
+
+    PushInstance(self, Type_Color, 0, IsOpaque(self, Type_Color, color), &inside);
+}
+
+// Pixels of the render target per logical pixel, for the antialiasing and the point sprites
+float PixelScale(OpenGLRenderer * const self)
+{
+    if (self->logical.x <= 0.0f)
+        return 1.0f;
+
+    return self->viewportRect.w * self->renderScale / self->logical.x;
+}
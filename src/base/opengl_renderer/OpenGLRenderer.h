@@ -28,6 +28,8 @@ SOFTWARE.
 #include "GLProgram.h"
 #include "GLBuffer.h"
 #include "GLTexture.h"
+#include "GLState.h"
+#include "GLFramebuffer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -36,6 +38,7 @@ extern "C" {
 typedef struct Rect Rect;
 typedef struct IRect IRect;
 typedef struct Color Color;
+typedef struct Animation Animation;
 
 typedef struct OpenGLRenderer OpenGLRenderer;
 
@@ -45,11 +48,51 @@ void OpenGLRenderer_Delete(OpenGLRenderer * const self);
 void OpenGLRenderer_InitGL(OpenGLRenderer * const self);
 
 Texture2D *OpenGLRenderer_CreateTexture(OpenGLRenderer * const self, const Image *image, TextureFilter filter);
+void OpenGLRenderer_UpdateTexture(OpenGLRenderer * const self, Texture2D *texture, const Image *image, TextureFilter filter);
+bool OpenGLRenderer_IsImageFormatSupported(OpenGLRenderer * const self, ImageFormat format);
 void OpenGLRenderer_DestroyTexture(OpenGLRenderer * const self, Texture2D *texture);
 void OpenGLRenderer_Clear(OpenGLRenderer * const self);
+void OpenGLRenderer_Flush(OpenGLRenderer * const self);
+// Flushes and, at a render scale below 1, upscales the scene to the viewport in one draw
+void OpenGLRenderer_EndFrame(OpenGLRenderer * const self);
+// Flushes and waits for the GPU to finish, for timing without a swap
+void OpenGLRenderer_Finish(OpenGLRenderer * const self);
+
+// Dynamic resolution: the scene is drawn at the viewport size times the scale, from 0.25 to 1.
+// The logical size and the letterboxing of the viewport don't change
+void OpenGLRenderer_SetRenderScale(OpenGLRenderer * const self, float scale);
+float OpenGLRenderer_RenderScale(OpenGLRenderer * const self);
+bool OpenGLRenderer_IsGpuTimerSupported(OpenGLRenderer * const self);
+// GPU seconds of a recent frame, from Clear to EndFrame. False without timer queries or a new result
+bool OpenGLRenderer_GpuFrameTime(OpenGLRenderer * const self, double *seconds);
+
+// Shades every fragment with the same dim color and adds them up, so the brightest areas are drawn over the most
+void OpenGLRenderer_SetOverdrawView(OpenGLRenderer * const self, bool enabled);
+bool OpenGLRenderer_IsOverdrawView(OpenGLRenderer * const self);
+
+// Renders into an offscreen framebuffer of this size instead of the window, 0 goes back to the window.
+// False if the framebuffer can't be created, the window is still used then
+bool OpenGLRenderer_SetOffscreen(OpenGLRenderer * const self, int width, int height);
+// Pixels of the whole render target, RGBA top row first. The caller frees them
+uint8_t *OpenGLRenderer_ReadPixels(OpenGLRenderer * const self, int *width, int *height);
 
 void OpenGLRenderer_Draw(OpenGLRenderer * const self, const Texture2D *texture, const IRect *srcrect, const Rect *dstrect, const float angle);
 void OpenGLRenderer_FillRect(OpenGLRenderer * const self, const Rect *rect, const Color *color);
+// The animation is evaluated by the vertex shader at the renderer time, NULL draws a still quad
+void OpenGLRenderer_DrawAnimated(OpenGLRenderer * const self, const Texture2D *texture, const IRect *srcrect, const Rect *dstrect, const float angle, const Animation *animation);
+void OpenGLRenderer_FillRectAnimated(OpenGLRenderer * const self, const Rect *rect, const Color *color, const Animation *animation);
+// Antialiased shapes computed per pixel, batched like FillRect and without textures. A thickness of 0 fills
+// the shape, above 0 only the outline is stroked, inwards: a ring for DrawCircle, a border for DrawRoundedRect
+void OpenGLRenderer_DrawRoundedRect(OpenGLRenderer * const self, const Rect *rect, float radius, float thickness, const Color *color, const Animation *animation);
+void OpenGLRenderer_DrawCircle(OpenGLRenderer * const self, float x, float y, float radius, float thickness, const Color *color);
+// A line with round caps
+void OpenGLRenderer_DrawLine(OpenGLRenderer * const self, float x1, float y1, float x2, float y2, float thickness, const Color *color);
+// Round particles in logical coordinates, a single draw for up to GLBUFFER_MAX_PARTICLES
+void OpenGLRenderer_DrawParticles(OpenGLRenderer * const self, const ParticleVertex *particles, int count);
+
+// Clock of the animations in seconds, set once per frame before drawing
+void OpenGLRenderer_SetTime(OpenGLRenderer * const self, double seconds);
+double OpenGLRenderer_Time(OpenGLRenderer * const self);
 
 void OpenGLRenderer_SetViewportSize(OpenGLRenderer * const self, int w, int h);
 void OpenGLRenderer_SetLogicalSize(OpenGLRenderer * const self, int w, int h);
@@ -0,0 +1,52 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+static const char particleFrag[] =
+                                                                                                                    "\n\
+#ifdef GL_ES                                                                                                         \n\
+    precision mediump float;                                                                                         \n\
+#endif                                                                                                               \n\
+                                                                                                                     \n\
+uniform float uOverdraw;                                                                                             \n\
+                                                                                                                     \n\
+varying vec4 vColor;                                                                                                 \n\
+varying vec2 vCoord;                                                                                                 \n\
+                                                                                                                     \n\
+void main()                                                                                                          \n\
+{                                                                                                                    \n\
+#if isInstanced                                                                                                      \n\
+    vec2 coord = vCoord;                                                                                             \n\
+#else                                                                                                                \n\
+    vec2 coord = gl_PointCoord * 2.0 - 1.0;                                                                          \n\
+#endif                                                                                                               \n\
+                                                                                                                     \n\
+    // A round dot with a soft edge                                                                                  \n\
+    float alpha = clamp((1.0 - length(coord)) * 3.0, 0.0, 1.0);                                                      \n\
+                                                                                                                     \n\
+    fragColor = vec4(vColor.rgb, vColor.a * alpha);                                                                  \n\
+                                                                                                                     \n\
+    if (uOverdraw > 0.0)                                                                                             \n\
+        fragColor = vec4(uOverdraw, uOverdraw * 0.5, uOverdraw * 0.25, 1.0);                                         \n\
+}                                                                                                                    \n\
+                                                                                                                     \n";
@@ -0,0 +1,55 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+static const char particleVert[] =
+                                                                                                                    "\n\
+// Particles are squares of aParticle.z logical pixels around aParticle.xy. Instanced quads on                       \n\
+// OpenGL 3.3 / OpenGL ES 3.0, point sprites before, sized in framebuffer pixels by uPixelScale                      \n\
+                                                                                                                     \n\
+attribute vec2 aPosition;                                                                                            \n\
+attribute vec3 aParticle;                                                                                            \n\
+attribute vec4 aColor;                                                                                               \n\
+                                                                                                                     \n\
+#if !hasUniformBuffer                                                                                                \n\
+uniform mat4 uProjection;                                                                                            \n\
+uniform float uPixelScale;                                                                                           \n\
+#endif                                                                                                               \n\
+                                                                                                                     \n\
+varying vec4 vColor;                                                                                                 \n\
+varying vec2 vCoord;                                                                                                 \n\
+                                                                                                                     \n\
+void main()                                                                                                          \n\
+{                                                                                                                    \n\
+    vColor = aColor;                                                                                                 \n\
+                                                                                                                     \n\
+#if isInstanced                                                                                                      \n\
+    vCoord = aPosition * 2.0 - 1.0;                                                                                  \n\
+    gl_Position = uProjection * vec4(aParticle.xy + (aPosition - 0.5) * aParticle.z, 0.0, 1.0);                      \n\
+#else                                                                                                                \n\
+    vCoord = vec2(0.0);                                                                                              \n\
+    gl_PointSize = aParticle.z * uPixelScale;                                                                        \n\
+    gl_Position = uProjection * vec4(aParticle.xy, 0.0, 1.0);                                                        \n\
+#endif                                                                                                               \n\
+}                                                                                                                    \n\
+                                                                                                                     \n";
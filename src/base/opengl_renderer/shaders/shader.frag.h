@@ -29,18 +29,47 @@ static const char frag[] =
 #endif                                                                                                               \n\
                                                                                                                      \n\
 uniform sampler2D uSampler;                                                                                          \n\
+uniform float uOverdraw;                                                                                             \n\
                                                                                                                      \n\
 varying vec2 vUV;                                                                                                    \n\
 varying vec4 vColor;                                                                                                 \n\
                                                                                                                      \n\
+#if hasShape                                                                                                         \n\
+#if !hasUniformBuffer                                                                                                \n\
+uniform float uPixelScale;                                                                                           \n\
+#endif                                                                                                               \n\
+                                                                                                                     \n\
+varying vec2 vLocal;                                                                                                 \n\
+varying vec4 vShape;                                                                                                 \n\
+                                                                                                                     \n\
+// shape: width, height, corner radius, stroke thickness (0 fills).                                                  \n\
+// Signed distance to a rounded box, turned into the covered fraction of the pixel                                   \n\
+float Coverage()                                                                                                     \n\
+{                                                                                                                    \n\
+    vec2 q = abs(vLocal) - vShape.xy * 0.5 + vShape.z;                                                               \n\
+    float distance = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - vShape.z;                                       \n\
+                                                                                                                     \n\
+    if (vShape.w > 0.0)                                                                                              \n\
+        distance = abs(distance + vShape.w * 0.5) - vShape.w * 0.5;                                                  \n\
+                                                                                                                     \n\
+    return clamp(0.5 - distance * uPixelScale, 0.0, 1.0);                                                            \n\
+}                                                                                                                    \n\
+#endif                                                                                                               \n\
+                                                                                                                     \n\
 void main()                                                                                                          \n\
 {                                                                                                                    \n\
 #ifdef hasTextureBGRA                                                                                                \n\
-    gl_FragColor = texture2D(uSampler, vUV).bgra;                                                                    \n\
+    fragColor = texture2D(uSampler, vUV).bgra;                                                                       \n\
 #elif hasTexture                                                                                                     \n\
-    gl_FragColor = texture2D(uSampler, vUV);                                                                         \n\
+    fragColor = texture2D(uSampler, vUV);                                                                            \n\
+#elif hasShape                                                                                                       \n\
+    fragColor = vec4(vColor.rgb, vColor.a * Coverage()) / 255.0;                                                     \n\
 #else                                                                                                                \n\
-    gl_FragColor = vColor / 255.0;                                                                                   \n\
+    fragColor = vColor / 255.0;                                                                                      \n\
 #endif                                                                                                               \n\
+                                                                                                                     \n\
+    // Overdraw view: every shaded fragment adds the same amount, blended additively                                 \n\
+    if (uOverdraw > 0.0)                                                                                             \n\
+        fragColor = vec4(uOverdraw, uOverdraw * 0.5, uOverdraw * 0.25, 1.0);                                         \n\
 }                                                                                                                    \n\
                                                                                                                      \n";
@@ -28,20 +28,92 @@ attribute vec2 aPosition;
 attribute vec2 aUV;                                                                                                  \n\
 attribute vec4 aColor;                                                                                               \n\
                                                                                                                      \n\
+#if isInstanced                                                                                                      \n\
+attribute vec4 aTransform;                                                                                           \n\
+attribute vec3 aTranslation; // and the depth                                                                        \n\
+attribute vec4 aSource;                                                                                              \n\
+attribute vec4 aAnimation;                                                                                           \n\
+attribute vec4 aSlide;                                                                                               \n\
+#else                                                                                                                \n\
 uniform mat3 uTransform;                                                                                             \n\
-uniform mat4 uProjection;                                                                                            \n\
 uniform vec4 uSourcePosition;                                                                                        \n\
+uniform vec4 uAnimation;                                                                                             \n\
+uniform vec4 uSlide;                                                                                                 \n\
+#endif                                                                                                               \n\
+                                                                                                                     \n\
+// In the Frame block with uniform buffers                                                                           \n\
+#if !hasUniformBuffer                                                                                                \n\
+uniform mat4 uProjection;                                                                                            \n\
+uniform float uTime;                                                                                                 \n\
+#endif                                                                                                               \n\
                                                                                                                      \n\
 varying vec2 vUV;                                                                                                    \n\
 varying vec4 vColor;                                                                                                 \n\
                                                                                                                      \n\
+#if hasShape                                                                                                         \n\
+varying vec2 vLocal;                                                                                                 \n\
+varying vec4 vShape;                                                                                                 \n\
+#endif                                                                                                               \n\
+                                                                                                                     \n\
+float Ease(float t, float easing)                                                                                    \n\
+{                                                                                                                    \n\
+    if (easing < 0.5)                                                                                                \n\
+        return t;                                                                                                    \n\
+    if (easing < 1.5)                                                                                                \n\
+        return t * (2.0 - t);                                                                                        \n\
+    if (easing < 2.5)                                                                                                \n\
+        return t * t * (3.0 - 2.0 * t);                                                                              \n\
+                                                                                                                     \n\
+    float u = 1.0 - t;                                                                                               \n\
+    return 1.0 - u * u * u;                                                                                          \n\
+}                                                                                                                    \n\
+                                                                                                                     \n\
+// animation: start time, degrees per second, pulse amplitude, pulse frequency                                       \n\
+// slide: offset at the start, duration, easing                                                                      \n\
+vec2 Animate(vec2 position, vec2 center, vec4 animation, vec4 slide)                                                 \n\
+{                                                                                                                    \n\
+    float t = uTime - animation.x;                                                                                   \n\
+    float angle = radians(animation.y * t);                                                                          \n\
+    float scale = 1.0 + animation.z * sin(6.2831853 * animation.w * t);                                              \n\
+    float progress = slide.z > 0.0 ? Ease(clamp(t / slide.z, 0.0, 1.0), slide.w) : 1.0;                              \n\
+                                                                                                                     \n\
+    vec2 offset = (position - center) * scale;                                                                       \n\
+    offset = vec2(cos(angle) * offset.x - sin(angle) * offset.y, sin(angle) * offset.x + cos(angle) * offset.y);     \n\
+                                                                                                                     \n\
+    return center + offset + slide.xy * (1.0 - progress);                                                            \n\
+}                                                                                                                    \n\
+                                                                                                                     \n\
 void main()                                                                                                          \n\
 {                                                                                                                    \n\
+#if isInstanced                                                                                                      \n\
+    mat3 transform = mat3(aTransform.xy, 0.0, aTransform.zw, 0.0, aTranslation.xy, 1.0);                             \n\
+    float depth = aTranslation.z;                                                                                    \n\
+    vec4 source = aSource;                                                                                           \n\
+    vec4 animation = aAnimation;                                                                                     \n\
+    vec4 slide = aSlide;                                                                                             \n\
+#else                                                                                                                \n\
+    mat3 transform = uTransform;                                                                                     \n\
+    float depth = 0.0;                                                                                               \n\
+    vec4 source = uSourcePosition;                                                                                   \n\
+    vec4 animation = uAnimation;                                                                                     \n\
+    vec4 slide = uSlide;                                                                                             \n\
+#endif                                                                                                               \n\
+                                                                                                                     \n\
+    vec2 position = (transform * vec3(aPosition, 1.0)).xy;                                                           \n\
+    vec2 center = (transform * vec3(0.5, 0.5, 1.0)).xy;                                                              \n\
+                                                                                                                     \n\
     vColor = aColor;                                                                                                 \n\
-    gl_Position = uProjection * vec4(uTransform * vec3(aPosition, 1.0), 1.0);                                        \n\
+    gl_Position = uProjection * vec4(Animate(position, center, animation, slide), 0.0, 1.0);                         \n\
+    gl_Position.z = depth;                                                                                           \n\
                                                                                                                      \n\
 #if hasTexture                                                                                                       \n\
-    vUV = uSourcePosition.xy + vec2(aUV.x * uSourcePosition.z, aUV.y * uSourcePosition.w);                           \n\
+    vUV = source.xy + vec2(aUV.x * source.z, aUV.y * source.w);                                                      \n\
+#endif                                                                                                               \n\
+                                                                                                                     \n\
+#if hasShape                                                                                                         \n\
+    // Logical pixels from the center. The quad is 2 pixels larger on every side, room for the antialiased edge      \n\
+    vLocal = (aPosition - 0.5) * (source.xy + 4.0);                                                                  \n\
+    vShape = source;                                                                                                 \n\
 #endif                                                                                                               \n\
 }                                                                                                                    \n\
                                                                                                                      \n";
@@ -23,62 +23,61 @@ SOFTWARE.
 -------------------------------------------------------------------------------*/
 
 #include "Timer.h"
-#include "../LinkedList.h"
 #include "../SceneManager.h"
+#include "../Vector.h"
 
+#include <stdbool.h>
+#include <stdio.h>
 #include <stdlib.h>
 
-#ifdef __EMSCRIPTEN__
-  #include <emscripten.h>
-#else
-  #include <SDL2/SDL_timer.h>
-#endif
-
 #include <SDL2/SDL.h>
 
-typedef struct TimerData
-{
-    SceneManager_TimerCallback callback;
-    void *userdata;
-
-#ifdef __EMSCRIPTEN__
-    Uint64 time;
-#else
-    SDL_TimerID timerId;
-#endif
-
-} TimerData;
+// Timers due first sit at the top of a binary min-heap. Entries come from a pool with a free list,
+// the heap only holds their indexes
 
-#ifndef __EMSCRIPTEN__
-static const int TimerEventCode = 42000;
+#define INDEX_BITS 16
+#define INDEX_MASK ((1u << INDEX_BITS) - 1)
+#define MAX_TIMERS INDEX_MASK
 
-static Uint32 TimerCallback(Uint32 interval, void *param)
+typedef struct TimerEntry
 {
-    (void)interval;
-
-    SDL_Event event = {.type = SDL_USEREVENT};
-    event.user = (SDL_UserEvent) {
-        .type = SDL_USEREVENT,
-        .code = TimerEventCode,
-        .data1 = param,
-    };
+    Timer_TimerCallback callback;
+    void *userdata;
+    Uint64 deadline;
+    uint32_t interval;
+    bool repeat;
+    uint32_t generation;
+    int heapIndex;
+    int nextFree;
+} TimerEntry;
 
-    SDL_PushEvent(&event);
-
-    return 0;
-}
-#endif
+VECTOR_TYPE(TimerEntries, TimerEntry)
+VECTOR_TYPE(TimerHeap, int)
 
 struct Timer
 {
-    LinkedList *timers;
+    TimerEntries entries;
+    TimerHeap heap;
+    int firstFree;
+    Uint64 now;
 };
 
+static Timer_Id AddEntry(Timer * const self, uint32_t interval, bool repeat, Timer_TimerCallback callback, void *userdata);
+static void FreeEntry(Timer * const self, int index);
+static TimerEntry *FindEntry(Timer * const self, Timer_Id id);
+static void RemoveFromHeap(Timer * const self, int heapIndex);
+static void SiftUp(Timer * const self, int heapIndex);
+static void SiftDown(Timer * const self, int heapIndex);
+static void Place(Timer * const self, int heapIndex, int index);
+
 Timer *Timer_New()
 {
     Timer * const self = malloc(sizeof (Timer));
 
-    self->timers = LinkedList_New();
+    TimerEntries_Init(&self->entries);
+    TimerHeap_Init(&self->heap);
+    self->firstFree = -1;
+    self->now = 0;
 
     return self;
 }
@@ -88,83 +87,200 @@ void Timer_Delete(Timer * const self)
     if (!self)
         return;
 
-    Timer_Clear(self);
-    LinkedList_Delete(self->timers);
-
+    TimerEntries_Free(&self->entries);
+    TimerHeap_Free(&self->heap);
     free(self);
 }
 
 void Timer_Clear(Timer * const self)
 {
-#ifndef __EMSCRIPTEN__
-    for (LinkedListNode *iterator = LinkedList_GetFirst(self->timers); iterator != NULL;)
+    while (self->heap.size > 0)
     {
-        TimerData *data = LinkedList_GetValuePtr(self->timers, iterator);
+        const int index = self->heap.data[0];
 
-        SDL_RemoveTimer(data->timerId);
-        free(data);
-        LinkedList_Next(self->timers, &iterator);
+        RemoveFromHeap(self, 0);
+        FreeEntry(self, index);
     }
-#endif
+}
 
-    LinkedList_Clear(self->timers);
+Timer_Id Timer_Add(Timer * const self, uint32_t interval, Timer_TimerCallback callback, void *userdata)
+{
+    return AddEntry(self, interval, false, callback, userdata);
 }
 
-void Timer_Add(Timer * const self, uint32_t interval, Timer_TimerCallback callback, void *userdata)
+Timer_Id Timer_AddRepeating(Timer * const self, uint32_t interval, Timer_TimerCallback callback, void *userdata)
 {
-    TimerData *data = malloc(sizeof (TimerData));
+    // A zero interval would fire on every pass of the same update
+    return AddEntry(self, interval > 0 ? interval : 1, true, callback, userdata);
+}
 
-    data->callback = callback;
-    data->userdata = userdata;
+void Timer_Cancel(Timer * const self, Timer_Id id)
+{
+    TimerEntry *entry = FindEntry(self, id);
 
-#ifdef __EMSCRIPTEN__
-    data->time = SDL_GetTicks64() + interval;
+    if (!entry || entry->heapIndex < 0)
+        return;
 
-    LinkedList_PushPtr(self->timers, data);
-#else
-    data->timerId = SDL_AddTimer(interval, TimerCallback, data);
+    const int index = entry - self->entries.data;
 
-    LinkedList_PushPtr(self->timers, data);
-#endif
+    RemoveFromHeap(self, entry->heapIndex);
+    FreeEntry(self, index);
 }
 
-void Timer_ProcessEvent(Timer * const self, SceneManager *sceneManager, SDL_Event *event)
+void Timer_SetTime(Timer * const self, uint64_t now)
 {
-#ifndef __EMSCRIPTEN__
-    if (event->type == SDL_USEREVENT && event->user.type == SDL_USEREVENT)
-    {
-        if (event->user.code == TimerEventCode)
-        {
-            TimerData *data = event->user.data1;
-
-            data->callback(sceneManager, data->userdata);
-
-            SDL_RemoveTimer(data->timerId);
-            LinkedList_RemoveFromValuePtr(self->timers, data);
-            free(data);
-        }
-    }
-#endif
+    self->now = now;
 }
 
 void Timer_Update(Timer * const self, SceneManager *sceneManager)
 {
-#ifdef __EMSCRIPTEN__
-    for (LinkedListNode *iterator = LinkedList_GetFirst(self->timers); iterator != NULL;)
+    const Uint64 now = self->now;
+
+    while (self->heap.size > 0 && self->entries.data[self->heap.data[0]].deadline <= now)
     {
-        TimerData *data = LinkedList_GetValuePtr(self->timers, iterator);
+        const int index = self->heap.data[0];
+        TimerEntry *entry = &self->entries.data[index];
 
-        if (SDL_GetTicks64() >= data->time)
+        // Copied out, the callback may add timers and move the pool
+        const Timer_TimerCallback callback = entry->callback;
+        void *userdata = entry->userdata;
+
+        if (entry->repeat)
         {
-            data->callback(sceneManager, data->userdata);
+            // Keeps the cadence, but doesn't burst to catch up after a long stall
+            entry->deadline += entry->interval;
+
+            if (entry->deadline <= now)
+                entry->deadline = now + entry->interval;
 
-            free(data);
-            LinkedList_Remove(self->timers, &iterator);
+            SiftDown(self, 0);
         }
         else
         {
-            LinkedList_Next(self->timers, &iterator);
+            RemoveFromHeap(self, 0);
+            FreeEntry(self, index);
+        }
+
+        callback(sceneManager, userdata);
+    }
+}
+
+Timer_Id AddEntry(Timer * const self, uint32_t interval, bool repeat, Timer_TimerCallback callback, void *userdata)
+{
+    int index = self->firstFree;
+
+    if (index < 0)
+    {
+        if (self->entries.size == MAX_TIMERS)
+        {
+            puts("Too many timers");
+            return 0;
         }
+
+        index = self->entries.size;
+        TimerEntries_Push(&self->entries)->generation = 0;
+    }
+    else
+    {
+        self->firstFree = self->entries.data[index].nextFree;
+    }
+
+    TimerEntry *entry = &self->entries.data[index];
+
+    entry->callback = callback;
+    entry->userdata = userdata;
+    entry->deadline = self->now + interval;
+    entry->interval = interval;
+    entry->repeat = repeat;
+
+    TimerHeap_Push(&self->heap);
+    Place(self, self->heap.size - 1, index);
+    SiftUp(self, entry->heapIndex);
+
+    return (entry->generation << INDEX_BITS) | (index + 1);
+}
+
+void FreeEntry(Timer * const self, int index)
+{
+    TimerEntry *entry = &self->entries.data[index];
+
+    // Old ids stop matching
+    entry->generation = (entry->generation + 1) & (UINT32_MAX >> INDEX_BITS);
+    entry->heapIndex = -1;
+    entry->nextFree = self->firstFree;
+    self->firstFree = index;
+}
+
+TimerEntry *FindEntry(Timer * const self, Timer_Id id)
+{
+    const int index = (int) (id & INDEX_MASK) - 1;
+
+    if (index < 0 || index >= (int) self->entries.size || self->entries.data[index].generation != id >> INDEX_BITS)
+        return NULL;
+
+    return &self->entries.data[index];
+}
+
+void RemoveFromHeap(Timer * const self, int heapIndex)
+{
+    const int last = self->heap.data[self->heap.size - 1];
+
+    TimerHeap_Pop(&self->heap);
+
+    if (heapIndex == (int) self->heap.size)
+        return;
+
+    Place(self, heapIndex, last);
+    SiftUp(self, heapIndex);
+    SiftDown(self, self->entries.data[last].heapIndex);
+}
+
+void SiftUp(Timer * const self, int heapIndex)
+{
+    const int index = self->heap.data[heapIndex];
+    const Uint64 deadline = self->entries.data[index].deadline;
+
+    while (heapIndex > 0)
+    {
+        const int parent = (heapIndex - 1) / 2;
+
+        if (self->entries.data[self->heap.data[parent]].deadline <= deadline)
+            break;
+
+        Place(self, heapIndex, self->heap.data[parent]);
+        heapIndex = parent;
+    }
+
+    Place(self, heapIndex, index);
+}
+
+void SiftDown(Timer * const self, int heapIndex)
+{
+    const int index = self->heap.data[heapIndex];
+    const Uint64 deadline = self->entries.data[index].deadline;
+
+    for (;;)
+    {
+        int child = heapIndex * 2 + 1;
+
+        if (child >= (int) self->heap.size)
+            break;
+
+        if (child + 1 < (int) self->heap.size && self->entries.data[self->heap.data[child + 1]].deadline < self->entries.data[self->heap.data[child]].deadline)
+            ++child;
+
+        if (deadline <= self->entries.data[self->heap.data[child]].deadline)
+            break;
+
+        Place(self, heapIndex, self->heap.data[child]);
+        heapIndex = child;
     }
-#endif
+
+    Place(self, heapIndex, index);
+}
+
+void Place(Timer * const self, int heapIndex, int index)
+{
+    self->heap.data[heapIndex] = index;
+    self->entries.data[index].heapIndex = heapIndex;
 }
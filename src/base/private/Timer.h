@@ -26,17 +26,23 @@ SOFTWARE.
 
 #include <stdint.h>
 
-typedef union SDL_Event SDL_Event;
-
 typedef struct SceneManager SceneManager;
 typedef struct Timer Timer;
 
 typedef void (*Timer_TimerCallback)(void * const manager, void *userdata);
 
+// 0 is never a valid timer, ids of finished or canceled timers are not reused for a long time
+typedef uint32_t Timer_Id;
+
 Timer *Timer_New();
 void Timer_Delete(Timer * const self);
 
 void Timer_Clear(Timer * const self);
-void Timer_Add(Timer * const self, uint32_t interval, Timer_TimerCallback callback, void *userdata);
-void Timer_ProcessEvent(Timer * const self, SceneManager *sceneManager, SDL_Event *event);
+Timer_Id Timer_Add(Timer * const self, uint32_t interval, Timer_TimerCallback callback, void *userdata);
+// Fires every interval milliseconds until canceled
+Timer_Id Timer_AddRepeating(Timer * const self, uint32_t interval, Timer_TimerCallback callback, void *userdata);
+// Does nothing for a timer that already finished
+void Timer_Cancel(Timer * const self, Timer_Id id);
+// Milliseconds on the scene clock, deadlines of new timers count from here
+void Timer_SetTime(Timer * const self, uint64_t now);
 void Timer_Update(Timer * const self, SceneManager *sceneManager);
@@ -30,14 +30,67 @@ SOFTWARE.
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+static void PrintUsage(const char *program);
 
 int main(int argc, char *argv[])
 {
-    (void)argc;(void)argv;
-
     setbuf(stdout, NULL);
 
-    App *app = App_New();
+    AppOptions options = {NULL, NULL, 0.0, false, false, 0, NULL, 0, 0.0, 1.0f, false};
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+            options.recordFile = argv[++i];
+
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+            options.replayFile = argv[++i];
+
+        else if (strcmp(argv[i], "--fixed-dt") == 0 && i + 1 < argc)
+            options.fixedDeltaTime = atof(argv[++i]);
+
+        else if (strcmp(argv[i], "--frame-stats") == 0)
+            options.frameStats = true;
+
+        else if (strcmp(argv[i], "--headless") == 0)
+            options.headless = true;
+
+        else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+            options.frames = strtoull(argv[++i], NULL, 10);
+
+        else if (strcmp(argv[i], "--snapshots") == 0 && i + 1 < argc)
+            options.snapshotDirectory = argv[++i];
+
+        else if (strcmp(argv[i], "--snapshot-every") == 0 && i + 1 < argc)
+            options.snapshotInterval = strtoull(argv[++i], NULL, 10);
+
+        else if (strcmp(argv[i], "--dynamic-resolution") == 0 && i + 1 < argc)
+            options.dynamicResolution = atof(argv[++i]) / 1000.0;
+
+        else if (strcmp(argv[i], "--render-scale") == 0 && i + 1 < argc)
+            options.renderScale = atof(argv[++i]);
+
+        else if (strcmp(argv[i], "--overdraw") == 0)
+            options.overdraw = true;
+
+        else
+        {
+            PrintUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Benchmarks need a fixed step to be deterministic, replays advance by the recorded steps
+    if (options.headless && options.fixedDeltaTime <= 0.0)
+        options.fixedDeltaTime = 1.0 / 60.0;
+
+    // A headless run needs an end
+    if (options.headless && !options.replayFile && options.frames == 0)
+        options.frames = 600;
+
+    App *app = App_New(&options);
 
     if (!app)
         return EXIT_FAILURE;
@@ -47,3 +100,20 @@ int main(int argc, char *argv[])
 
     return EXIT_SUCCESS;
 }
+
+void PrintUsage(const char *program)
+{
+    printf("Usage: %s [options]\n"
+           "  --record FILE     records the input of the session\n"
+           "  --replay FILE     replays recorded input, then quits\n"
+           "  --fixed-dt SEC    fixed update step, 1/60 by default when headless\n"
+           "  --frame-stats     prints the frame time histogram on exit\n"
+           "  --headless        renders offscreen, 600 frames unless replaying or --frames\n"
+           "  --frames N        quits after N frames\n"
+           "  --snapshots DIR   saves PNGs of the last frame of --frames or --replay\n"
+           "  --snapshot-every N  and of every N-th frame\n"
+           "  --dynamic-resolution MS  lowers the render scale while the GPU takes over MS per frame\n"
+           "  --render-scale S  draws the scene at S times the window resolution, 0.25 to 1\n"
+           "  --overdraw        shows how many times each pixel is drawn\n",
+           program);
+}
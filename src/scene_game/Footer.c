@@ -25,6 +25,7 @@ SOFTWARE.
 #include "Footer.h"
 #include "../base/Button.h"
 #include "../base/Texture.h"
+#include "../base/Layout.h"
 #include "../base/Box.h"
 
 #include <malloc.h>
@@ -33,6 +34,7 @@ struct Footer
 {
     OpenGLRenderer *renderer;
     SceneGameRect *sceneGameRect;
+    Layout *layout;
 
     Button *restartButton;
     Texture *copyrightText;
@@ -40,6 +42,7 @@ struct Footer
 
 void Footer_CreateRestartButton(Footer * const self);
 void Footer_CreateCopyrightText(Footer * const self);
+void Footer_CreateLayout(Footer * const self);
 
 Footer *Footer_New(OpenGLRenderer *renderer, SceneGameRect *sceneGameRect)
 {
@@ -50,6 +53,7 @@ Footer *Footer_New(OpenGLRenderer *renderer, SceneGameRect *sceneGameRect)
 
     Footer_CreateRestartButton(self);
     Footer_CreateCopyrightText(self);
+    Footer_CreateLayout(self);
 
     return self;
 }
@@ -59,17 +63,13 @@ void Footer_Delete(Footer * const self)
     if (!self)
         return;
 
+    Layout_Delete(self->layout);
     Button_Delete(self->restartButton);
     Texture_Delete(self->copyrightText);
 
     free(self);
 }
 
-void Footer_ProcessEvent(Footer * const self, const SDL_Event *event)
-{
-    Button_ProcessEvent(self->restartButton, event);
-}
-
 void Footer_Draw(Footer * const self)
 {
     Button_Draw(self->restartButton);
@@ -81,20 +81,19 @@ Button *Footer_GetRestartButton(Footer * const self)
     return self->restartButton;
 }
 
+void Footer_Resize(Footer * const self)
+{
+    Layout_SetPosition(self->layout, self->sceneGameRect->sidebar_w, 0);
+    Layout_SetSize(self->layout, self->sceneGameRect->content_w, self->sceneGameRect->window_h);
+    Layout_Update(self->layout);
+}
+
 void Footer_CreateRestartButton(Footer * const self)
 {
     self->restartButton = Button_New(self->renderer);
 
     Button_SetText(self->restartButton, "Reiniciar", 16);
-
-    int width = 110;
-    int height = 32;
-    int padding = 40;
-
-    Box_SetSize(Button_Box(self->restartButton), width, height);
-    Box_SetPosition(Button_Box(self->restartButton),
-                    self->sceneGameRect->sidebar_w + ((self->sceneGameRect->content_w - width) / 2),
-                    self->sceneGameRect->window_h - height - padding);
+    Box_SetSize(Button_Box(self->restartButton), 110, 32);
 }
 
 void Footer_CreateCopyrightText(Footer * const self)
@@ -105,13 +104,24 @@ void Footer_CreateCopyrightText(Footer * const self)
     Texture_SetTextSize(self->copyrightText, 14);
     Texture_SetTextColorRGB(self->copyrightText, 30, 120, 120);
     Texture_MakeText(self->copyrightText);
+}
 
-    int width = Texture_GetWidth(self->copyrightText);
-    int height = Texture_GetHeight(self->copyrightText);
-    int padding = 10;
-
-    Box_SetSize(Texture_Box(self->copyrightText), width, height);
-    Box_SetPosition(Texture_Box(self->copyrightText),
-                    self->sceneGameRect->sidebar_w + ((self->sceneGameRect->content_w - width) / 2),
-                    self->sceneGameRect->window_h - height - padding);
+void Footer_CreateLayout(Footer * const self)
+{
+    // Both are centered in the content and keep their own distance to the bottom of the window
+    self->layout = Layout_New(Layout_Stack);
+    Layout_SetAlign(self->layout, Layout_Center);
+    Layout_SetJustify(self->layout, Layout_End);
+
+    Layout *button = Layout_New(Layout_Row);
+    Layout_SetContent(button, Button_Box(self->restartButton));
+    Layout_SetMargin(button, 0.f, 0.f, 40.f, 0.f);
+    Layout_AddChild(self->layout, button);
+
+    Layout *copyright = Layout_New(Layout_Row);
+    Layout_SetContent(copyright, Texture_Box(self->copyrightText));
+    Layout_SetMargin(copyright, 0.f, 0.f, 10.f, 0.f);
+    Layout_AddChild(self->layout, copyright);
+
+    Footer_Resize(self);
 }
@@ -31,6 +31,6 @@ typedef struct Footer Footer;
 
 Footer *Footer_New(OpenGLRenderer *renderer, SceneGameRect *sceneGameRect);
 void Footer_Delete(Footer * const self);
-void Footer_ProcessEvent(Footer * const self, const SDL_Event *event);
 void Footer_Draw(Footer * const self);
 Button *Footer_GetRestartButton(Footer * const self);
+void Footer_Resize(Footer * const self);
@@ -24,12 +24,24 @@ SOFTWARE.
 
 #include "Header.h"
 #include "../base/Texture.h"
+#include "../base/Animation.h"
 #include "../base/Rectangle.h"
+#include "../base/Layout.h"
 #include "../base/Box.h"
+#include "../base/Tween.h"
+#include "../base/opengl_renderer/OpenGLRenderer.h"
 
 #include <malloc.h>
 #include <math.h>
 
+// Speed of the line sliding under the current player, in pixels per second
+static const float LineSpeed = 800.f;
+
+// The result panel drops from above its place when the game ends
+static const float PanelMarginTop = 18.f;
+static const float PanelDrop = 60.f;
+static const float PanelDropDuration = 0.35f;
+
 struct Header
 {
     int space;
@@ -39,54 +51,69 @@ struct Header
 
     OpenGLRenderer *renderer;
     SceneGameRect *sceneGameRect;
+    Tween *tween;
 
     Rectangle *background1;
     Rectangle *background2;
     Rectangle *line;
+    Animation lineSlide;
 
     Player currentPlayer;
     Player gameResult;
 
+    Layout *layout;
+    Layout *resultPanel;
+    Layout *resultNode;
+    Layout *player1Side;
+    Layout *player2Side;
+
     Texture *result;
     Texture *player1;
     Texture *player1Icon;
     Texture *player2;
     Texture *player2Icon;
+
+    Tween_Id resultTween;
+    float resultDrop;
 };
 
 void Header_CreateBackgrounds(Header * const self);
 void Header_CreateResultText(Header * const self);
 void Header_CreatePlayer1Text(Header * const self);
 void Header_CreatePlayer2Text(Header * const self);
+void Header_CreateLayout(Header * const self);
+Layout *Header_CreatePlayerSide(Header * const self, Texture *text, Texture *icon, float icon_y, bool left);
+Layout *Header_AddLeaf(Box *content);
 void Header_SetupResultText(Header * const self);
-void Header_SetupPlayer1Text(Header * const self);
-void Header_SetupPlayer2Text(Header * const self);
+void Header_SlideLine(Header * const self);
+void Header_PlaceResultPanel(Header * const self);
+void Header_OnResultDropped(void *userdata);
+void Header_OnPlayerIconLoaded(Texture * const texture, bool loaded, void *userdata);
 
-Header *Header_New(OpenGLRenderer *renderer, SceneGameRect *sceneGameRect)
+Header *Header_New(OpenGLRenderer *renderer, SceneGameRect *sceneGameRect, Tween *tween)
 {
     Header * const self = malloc(sizeof (Header));
 
     self->space = 6;
     self->margin = 20;
 
-    const float w = 134;
-    const float x = sceneGameRect->sidebar_w + ((sceneGameRect->content_w - w) / 2);
-    self->line_p1_x = x - 85.f;
-    self->line_p2_x = x + 85.f;
-
     self->renderer = renderer;
     self->sceneGameRect = sceneGameRect;
+    self->tween = tween;
     self->currentPlayer = Player_1;
+    self->resultTween = 0;
+    self->resultDrop = 0.f;
     self->gameResult = None;
 
-    self->line = Rectangle_New(self->renderer, w, 4.f);
-    Box_SetPosition(Rectangle_Box(self->line), self->line_p1_x, 64.f);
+    self->line = Rectangle_New(self->renderer, 134.f, 4.f);
     Rectangle_SetColorRGBA(self->line, 100, 180, 180, 255);
+    self->lineSlide = (Animation) {0};
 
     Header_CreateBackgrounds(self);
     Header_CreateResultText(self);
     Header_CreatePlayer1Text(self);
     Header_CreatePlayer2Text(self);
+    Header_CreateLayout(self);
 
     return self;
 }
@@ -96,6 +123,9 @@ void Header_Delete(Header * const self)
     if (!self)
         return;
 
+    Tween_Cancel(self->tween, self->resultTween);
+    Layout_Delete(self->layout);
+
     Rectangle_Delete(self->line);
     Rectangle_Delete(self->background1);
     Rectangle_Delete(self->background2);
@@ -114,16 +144,10 @@ void Header_ProcessEvent(Header * const self, const SDL_Event *event)
     (void)self;(void)event;
 }
 
-void Header_Update(Header * const self, double deltaTime)
+void Header_Update(Header * const self)
 {
-    Box * const lineBox = Rectangle_Box(self->line);
-    const float x = Box_X(lineBox);
-
-    if (self->currentPlayer == Player_1 && x >= self->line_p1_x)
-        Box_SetX(lineBox, fmax(x - (800.0 * deltaTime), self->line_p1_x));
-
-    else if (self->currentPlayer == Player_2 && x <= self->line_p2_x)
-        Box_SetX(lineBox, fmin(x + (800.0 * deltaTime), self->line_p2_x));
+    if (self->resultTween)
+        Header_PlaceResultPanel(self);
 }
 
 void Header_Draw(Header * const self)
@@ -146,11 +170,36 @@ void Header_Draw(Header * const self)
     }
 }
 
+void Header_Resize(Header * const self)
+{
+    const int half_w = self->sceneGameRect->content_w / 2;
+
+    Layout_SetPosition(self->layout, self->sceneGameRect->sidebar_w, 0);
+    Layout_SetSize(self->layout, self->sceneGameRect->content_w, -1.f);
+    Layout_SetSize(self->player1Side, half_w, -1.f);
+    Layout_SetSize(self->player2Side, self->sceneGameRect->content_w - half_w, -1.f);
+    Layout_Update(self->layout);
+
+    // The line slides between the two players, it jumps to the end of the move
+    Box * const lineBox = Rectangle_Box(self->line);
+    const float x = self->sceneGameRect->sidebar_w + ((self->sceneGameRect->content_w - Box_Width(lineBox)) / 2);
+
+    self->line_p1_x = x - 85.f;
+    self->line_p2_x = x + 85.f;
+
+    Box_SetPosition(lineBox, self->currentPlayer == Player_2 ? self->line_p2_x : self->line_p1_x, 64.f);
+
+    self->lineSlide = (Animation) {0};
+    Rectangle_SetAnimation(self->line, NULL);
+}
+
 void Header_SetCurrentPlayer(Header * const self, Player currentPlayer, Player gameResult)
 {
     self->currentPlayer = currentPlayer;
     self->gameResult = gameResult;
 
+    Header_SlideLine(self);
+
     if (self->gameResult == Player_1)
         Texture_SetText(self->result, "Vitória do jogador 1");
 
@@ -164,6 +213,11 @@ void Header_SetCurrentPlayer(Header * const self, Player currentPlayer, Player g
     {
         Texture_MakeText(self->result);
         Header_SetupResultText(self);
+
+        Tween_Cancel(self->tween, self->resultTween);
+        self->resultTween = Tween_Add(self->tween, &self->resultDrop, -PanelDrop, 0.f, PanelDropDuration, Easing_CubicOut);
+        Tween_SetOnComplete(self->tween, self->resultTween, Header_OnResultDropped, self);
+        Header_PlaceResultPanel(self);
     }
 }
 
@@ -175,24 +229,17 @@ void Header_CreateResultText(Header * const self)
     Texture_SetTextSize(self->result, 24);
     Texture_SetTextColorRGB(self->result, 30, 120, 120);
     Texture_MakeText(self->result);
-
-    Header_SetupResultText(self);
 }
 
 void Header_CreateBackgrounds(Header * const self)
 {
-    int w = 302, h = 58;
-    int x = self->sceneGameRect->sidebar_w + ((self->sceneGameRect->content_w - w) / 2);
-    int y = 18;
-
-    self->background1 = Rectangle_New(self->renderer, w, h);
-    Box_SetPosition(Rectangle_Box(self->background1), x, y);
+    self->background1 = Rectangle_New(self->renderer, 302, 58);
     Rectangle_SetColorRGBA(self->background1, 120, 200, 200, 255);
 
-    w -= 2; h -= 2; x -= 2; y -= 2;
-
-    self->background2 = Rectangle_New(self->renderer, w, h);
-    Box_SetPosition(Rectangle_Box(self->background2), x, y);
+    // Offset by the border, the first background shows only on the right and bottom edges
+    self->background2 = Rectangle_New(self->renderer, 300, 56);
+    Box_SetParent(Rectangle_Box(self->background2), Rectangle_Box(self->background1));
+    Box_SetPosition(Rectangle_Box(self->background2), -2, -2);
     Rectangle_SetColorRGBA(self->background2, 230, 240, 240, 255);
 }
 
@@ -206,9 +253,8 @@ void Header_CreatePlayer1Text(Header * const self)
     Texture_MakeText(self->player1);
 
     self->player1Icon = Texture_New(self->renderer);
+    Texture_SetOnLoadedEvent(self->player1Icon, Header_OnPlayerIconLoaded, self);
     Texture_LoadImageFromFile(self->player1Icon, "images/player_1.png", Nearest);
-
-    Header_SetupPlayer1Text(self);
 }
 
 void Header_CreatePlayer2Text(Header * const self)
@@ -221,50 +267,137 @@ void Header_CreatePlayer2Text(Header * const self)
     Texture_MakeText(self->player2);
 
     self->player2Icon = Texture_New(self->renderer);
+    Texture_SetOnLoadedEvent(self->player2Icon, Header_OnPlayerIconLoaded, self);
     Texture_LoadImageFromFile(self->player2Icon, "images/player_2.png", Nearest);
+}
+
+void Header_CreateLayout(Header * const self)
+{
+    // The result panel and the players row share the same place, only one of them is drawn
+    self->layout = Layout_New(Layout_Stack);
+    Layout_SetAlign(self->layout, Layout_Center);
+
+    Layout *panel = Layout_New(Layout_Column);
+    Layout_SetSize(panel, Box_Width(Rectangle_Box(self->background1)), Box_Height(Rectangle_Box(self->background1)));
+    Layout_SetMargin(panel, PanelMarginTop, 0.f, 0.f, 0.f);
+    Layout_SetPadding(panel, 8.f, 0.f, 0.f, 0.f);
+    Layout_SetAlign(panel, Layout_Center);
+    Layout_SetContent(panel, Rectangle_Box(self->background1));
+    Layout_AddChild(self->layout, panel);
+    self->resultPanel = panel;
+
+    self->resultNode = Header_AddLeaf(Texture_Box(self->result));
+    Layout_AddChild(panel, self->resultNode);
+
+    // The icons are around the center of the content, whatever the width of the texts
+    Layout *players = Layout_New(Layout_Row);
+    Layout_SetMargin(players, 30.f, 0.f, 0.f, 0.f);
+    Layout_AddChild(self->layout, players);
+
+    self->player1Side = Header_CreatePlayerSide(self, self->player1, self->player1Icon, 2.f, true);
+    self->player2Side = Header_CreatePlayerSide(self, self->player2, self->player2Icon, 3.f, false);
+    Layout_AddChild(players, self->player1Side);
+    Layout_AddChild(players, self->player2Side);
+
+    Header_Resize(self);
+}
+
+Layout *Header_CreatePlayerSide(Header * const self, Texture *text, Texture *icon, float icon_y, bool left)
+{
+    const float icon_size = left ? 28.f : 26.f;
 
-    Header_SetupPlayer2Text(self);
+    Layout *side = Layout_New(Layout_Row);
+    Layout_SetGap(side, self->space);
+
+    if (left)
+    {
+        Layout_SetJustify(side, Layout_End);
+        Layout_SetPadding(side, 0.f, self->margin, 0.f, 0.f);
+    }
+    else
+    {
+        Layout_SetPadding(side, 0.f, 0.f, 0.f, self->margin);
+    }
+
+    // Until it is loaded, the box of the icon is empty
+    Box_SetSize(Texture_Box(icon), icon_size, icon_size);
+
+    Layout *textNode = Header_AddLeaf(Texture_Box(text));
+    Layout *iconNode = Header_AddLeaf(Texture_Box(icon));
+    Layout_SetSize(iconNode, icon_size, icon_size);
+    Layout_SetMargin(iconNode, icon_y, 0.f, 0.f, 0.f);
+
+    // The icons face each other
+    Layout_AddChild(side, left ? textNode : iconNode);
+    Layout_AddChild(side, left ? iconNode : textNode);
+
+    return side;
 }
 
-void Header_SetupResultText(Header * const self)
+Layout *Header_AddLeaf(Box *content)
 {
-    int w = Texture_GetWidth(self->result);
-    int h = Texture_GetHeight(self->result);
+    Layout *node = Layout_New(Layout_Row);
 
-    Box_SetSize(Texture_Box(self->result), w, h);
-    Box_SetPosition(Texture_Box(self->result), self->sceneGameRect->sidebar_w + ((self->sceneGameRect->content_w - w) / 2), 26);
+    Layout_SetContent(node, content);
+
+    return node;
 }
 
-void Header_SetupPlayer1Text(Header * const self)
+void Header_SetupResultText(Header * const self)
 {
-    int text_w = Texture_GetWidth(self->player1);
-    int text_h = Texture_GetHeight(self->player1);
-    int icon_w = 28;
-    int icon_h = 28;
+    // The panel has a fixed size, so only the text is placed again
+    Layout_Invalidate(self->resultNode);
+    Layout_Update(self->layout);
+}
 
-    int text_x = (self->sceneGameRect->sidebar_w + ((self->sceneGameRect->content_w - text_w) / 2)) - (text_w / 2) - self->margin - icon_w - self->space;
-    int icon_x = (self->sceneGameRect->sidebar_w + ((self->sceneGameRect->content_w - icon_w) / 2)) - (icon_w / 2) - self->margin;
+void Header_OnPlayerIconLoaded(Texture * const texture, bool loaded, void *userdata)
+{
+    (void)loaded;
 
-    Box_SetSize(Texture_Box(self->player1), text_w, text_h);
-    Box_SetPosition(Texture_Box(self->player1), text_x, 30);
+    Header * const self = userdata;
 
-    Box_SetSize(Texture_Box(self->player1Icon), icon_w, icon_h);
-    Box_SetPosition(Texture_Box(self->player1Icon), icon_x, 32);
+    // The upload resets the box to the image size, the node of the icon keeps its place
+    if (texture == self->player1Icon)
+        Box_SetSize(Texture_Box(texture), 28, 28);
+    else
+        Box_SetSize(Texture_Box(texture), 26, 26);
 }
 
-void Header_SetupPlayer2Text(Header * const self)
+void Header_SlideLine(Header * const self)
 {
-    int text_w = Texture_GetWidth(self->player2);
-    int text_h = Texture_GetHeight(self->player2);
-    int icon_w = 26;
-    int icon_h = 26;
+    Box * const lineBox = Rectangle_Box(self->line);
+    const float target = self->currentPlayer == Player_2 ? self->line_p2_x : self->line_p1_x;
+    const float now = OpenGLRenderer_Time(self->renderer);
+
+    // The box is already at the end of the previous slide, the line may still be on its way there
+    float progress = 1.f;
+
+    if (self->lineSlide.slideDuration > 0.f)
+        progress = fminf(fmaxf((now - self->lineSlide.startTime) / self->lineSlide.slideDuration, 0.f), 1.f);
 
-    int text_x = (self->sceneGameRect->sidebar_w + ((self->sceneGameRect->content_w - text_w) / 2)) + (text_w / 2) + self->margin + icon_w + self->space;
-    int icon_x = (self->sceneGameRect->sidebar_w + ((self->sceneGameRect->content_w - icon_w) / 2)) + (icon_w / 2) + self->margin;
+    const float x = Box_X(lineBox) + (self->lineSlide.slideX * (1.f - progress));
 
-    Box_SetSize(Texture_Box(self->player2), text_w, text_h);
-    Box_SetPosition(Texture_Box(self->player2), text_x, 30);
+    self->lineSlide = (Animation) {
+        .startTime = now,
+        .slideX = x - target,
+        .slideDuration = fabsf(x - target) / LineSpeed,
+        .slideEasing = Easing_Linear,
+    };
+
+    Box_SetX(lineBox, target);
+    Rectangle_SetAnimation(self->line, &self->lineSlide);
+}
+
+void Header_PlaceResultPanel(Header * const self)
+{
+    Layout_SetMargin(self->resultPanel, PanelMarginTop + self->resultDrop, 0.f, 0.f, 0.f);
+    Layout_Update(self->layout);
+}
+
+void Header_OnResultDropped(void *userdata)
+{
+    Header * const self = userdata;
 
-    Box_SetSize(Texture_Box(self->player2Icon), icon_w, icon_h);
-    Box_SetPosition(Texture_Box(self->player2Icon), icon_x, 33);
+    self->resultTween = 0;
+    Header_PlaceResultPanel(self);
 }
@@ -27,11 +27,15 @@ SOFTWARE.
 #include "SceneGameRect.h"
 #include "board/board_util.h"
 
+typedef union SDL_Event SDL_Event;
+typedef struct Tween Tween;
+
 typedef struct Header Header;
 
-Header *Header_New(OpenGLRenderer *renderer, SceneGameRect *sceneGameRect);
+Header *Header_New(OpenGLRenderer *renderer, SceneGameRect *sceneGameRect, Tween *tween);
 void Header_Delete(Header * const self);
 void Header_ProcessEvent(Header * const self, const SDL_Event *event);
-void Header_Update(Header * const self, double deltaTime);
+void Header_Update(Header * const self);
 void Header_Draw(Header * const self);
 void Header_SetCurrentPlayer(Header * const self, Player currentPlayer, Player gameResult);
+void Header_Resize(Header * const self);
@@ -31,17 +31,39 @@ SOFTWARE.
 #include "../base/Button.h"
 #include "../base/Texture.h"
 #include "../base/Rectangle.h"
+#include "../base/Box.h"
+#include "../base/ParticleSystem.h"
 #include "../base/rect.h"
 #include "board/board_util.h"
 #include "Sidebar.h"
 #include "Header.h"
 #include "Footer.h"
 
+#include <SDL2/SDL.h>
+
 #include "malloc.h"
 
+static const int MaxParticles = 32768;
+static const float ParticleGravity = 700.0f;
+
+static const Color WinColors[] = {
+    {255, 200, 40, 255},
+    {255, 110, 90, 255},
+    {80, 200, 120, 255},
+    {70, 150, 255, 255},
+    {200, 110, 255, 255},
+};
+
+static const Color TiedColors[] = {
+    {80, 160, 160, 255},
+    {120, 200, 200, 255},
+    {230, 240, 240, 255},
+};
+
 struct SceneGame
 {
     OpenGLRenderer *renderer;
+    InputRouter *inputRouter;
     SceneGameRect sceneGameRect;
 
     int player1WinCount;
@@ -53,11 +75,15 @@ struct SceneGame
     Sidebar *sidebar;
     Header *header;
     Footer *footer;
+    ParticleSystem *particles;
 };
 
+void SceneGame_SetupRect(SceneGame * const self, int width, int height);
+void SceneGame_Resize(SceneGame * const self, int width, int height);
 void SceneGame_NewGame(SceneGame * const self);
 void SceneGame_OnPressed(Button * const button, void *user);
 void SceneGame_OnGameEvent(GameBoard * const game, void *user);
+void SceneGame_Celebrate(SceneGame * const self, Player gameResult);
 
 SceneGame *SceneGame_OnNew(SceneManager *sceneManager)
 {
@@ -67,14 +93,10 @@ SceneGame *SceneGame_OnNew(SceneManager *sceneManager)
     Graphics *graphics = SceneManager_Graphics(sceneManager);
     IVec2 windowSize = Window_GetSize(window);
 
-    self->sceneGameRect.window_w = windowSize.w;
-    self->sceneGameRect.window_h = windowSize.h;
-    self->sceneGameRect.sidebar_w = 200;
-    self->sceneGameRect.sidebar_h = windowSize.h;
-    self->sceneGameRect.content_w = windowSize.w - self->sceneGameRect.sidebar_w;
-    self->sceneGameRect.content_h = windowSize.h;
+    SceneGame_SetupRect(self, windowSize.w, windowSize.h);
 
     self->renderer = Graphics_GetRenderer(graphics);
+    self->inputRouter = SceneManager_InputRouter(sceneManager);
 
     self->player1WinCount = 0;
     self->player2WinCount = 0;
@@ -83,13 +105,16 @@ SceneGame *SceneGame_OnNew(SceneManager *sceneManager)
     self->background = Rectangle_New(self->renderer, self->sceneGameRect.window_w, self->sceneGameRect.window_h);
     self->gameBoard = NULL;
     self->sidebar = Sidebar_New(self->renderer, &self->sceneGameRect);
-    self->header = Header_New(self->renderer, &self->sceneGameRect);
+    self->header = Header_New(self->renderer, &self->sceneGameRect, SceneManager_Tween(sceneManager));
     self->footer = Footer_New(self->renderer, &self->sceneGameRect);
+    self->particles = ParticleSystem_New(self->renderer, MaxParticles);
 
     Rectangle_SetColorRGBA(self->background, 190, 225, 225, 255);
+    ParticleSystem_SetGravity(self->particles, 0.0f, ParticleGravity);
 
     Button *restartButton = Footer_GetRestartButton(self->footer);
     Button_SetOnPressEvent(restartButton, SceneGame_OnPressed, self);
+    Button_SetInputRouter(restartButton, self->inputRouter);
 
     SceneGame_NewGame(self);
 
@@ -102,6 +127,7 @@ void SceneGame_OnDelete(SceneGame * const self)
         return;
 
     GameBoard_Delete(self->gameBoard);
+    ParticleSystem_Delete(self->particles);
     Footer_Delete(self->footer);
     Header_Delete(self->header);
     Sidebar_Delete(self->sidebar);
@@ -112,15 +138,18 @@ void SceneGame_OnDelete(SceneGame * const self)
 
 void SceneGame_OnProcessEvent(SceneGame * const self, const SDL_Event *event)
 {
+    // Buttons get their pointer events from the input router
     Header_ProcessEvent(self->header, event);
-    Footer_ProcessEvent(self->footer, event);
-    GameBoard_ProcessEvent(self->gameBoard, event);
+
+    if (event->type == SDL_WINDOWEVENT && event->window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+        SceneGame_Resize(self, event->window.data1, event->window.data2);
 }
 
 void SceneGame_OnUpdate(SceneGame * const self, double deltaTime)
 {
-    Header_Update(self->header, deltaTime);
-    GameBoard_Update(self->gameBoard, deltaTime);
+    // The header line and the board icons are animated by the renderer
+    Header_Update(self->header);
+    ParticleSystem_Update(self->particles, deltaTime);
 }
 
 void SceneGame_OnDraw(SceneGame * const self)
@@ -130,15 +159,43 @@ void SceneGame_OnDraw(SceneGame * const self)
     Header_Draw(self->header);
     Footer_Draw(self->footer);
     Sidebar_Draw(self->sidebar);
+    ParticleSystem_Draw(self->particles);
+}
+
+void SceneGame_SetupRect(SceneGame * const self, int width, int height)
+{
+    self->sceneGameRect.window_w = width;
+    self->sceneGameRect.window_h = height;
+    self->sceneGameRect.sidebar_w = 200;
+    self->sceneGameRect.sidebar_h = height;
+    self->sceneGameRect.content_w = width - self->sceneGameRect.sidebar_w;
+    self->sceneGameRect.content_h = height;
+}
+
+void SceneGame_Resize(SceneGame * const self, int width, int height)
+{
+    if (width == self->sceneGameRect.window_w && height == self->sceneGameRect.window_h)
+        return;
+
+    SceneGame_SetupRect(self, width, height);
+
+    // Only boxes change, every texture is kept
+    Box_SetSize(Rectangle_Box(self->background), width, height);
+    Sidebar_Resize(self->sidebar);
+    Header_Resize(self->header);
+    Footer_Resize(self->footer);
+    GameBoard_Resize(self->gameBoard);
 }
 
 void SceneGame_NewGame(SceneGame * const self)
 {
     GameBoard_Delete(self->gameBoard);
+    ParticleSystem_Clear(self->particles);
 
     self->gameBoard = GameBoard_New(self->renderer, &self->sceneGameRect);
 
     GameBoard_SetGameEvent(self->gameBoard, SceneGame_OnGameEvent, self);
+    GameBoard_SetInputRouter(self->gameBoard, self->inputRouter);
     Header_SetCurrentPlayer(self->header, Player_1, None);
 }
 
@@ -164,4 +221,42 @@ void SceneGame_OnGameEvent(GameBoard * const gameBoard, void *user)
 
     else if (gameResult == Tied)
         Sidebar_SetTiedCountText(self->sidebar, ++self->tiedCount);
+
+    SceneGame_Celebrate(self, gameResult);
+}
+
+void SceneGame_Celebrate(SceneGame * const self, Player gameResult)
+{
+    const SceneGameRect *rect = &self->sceneGameRect;
+
+    if (gameResult == Player_1 || gameResult == Player_2)
+    {
+        // Three fountains along the bottom of the board
+        for (int i = 1; i <= 3; ++i)
+        {
+            ParticleSystem_Burst(self->particles, &(ParticleBurst) {
+                .x = rect->sidebar_w + rect->content_w * i / 4.0f,
+                .y = rect->content_h,
+                .count = 5000,
+                .minSpeed = 300.0f, .maxSpeed = 900.0f,
+                .direction = -90.0f, .spread = 50.0f,
+                .minLifetime = 1.2f, .maxLifetime = 2.4f,
+                .minSize = 3.0f, .maxSize = 8.0f,
+                .colors = WinColors, .colorsCount = sizeof (WinColors) / sizeof (Color),
+            });
+        }
+    }
+    else if (gameResult == Tied)
+    {
+        ParticleSystem_Burst(self->particles, &(ParticleBurst) {
+            .x = rect->sidebar_w + rect->content_w / 2.0f,
+            .y = rect->content_h / 2.0f,
+            .count = 6000,
+            .minSpeed = 50.0f, .maxSpeed = 450.0f,
+            .direction = 0.0f, .spread = 360.0f,
+            .minLifetime = 0.8f, .maxLifetime = 1.6f,
+            .minSize = 3.0f, .maxSize = 6.0f,
+            .colors = TiedColors, .colorsCount = sizeof (TiedColors) / sizeof (Color),
+        });
+    }
 }
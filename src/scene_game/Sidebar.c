@@ -25,6 +25,7 @@ SOFTWARE.
 #include "Sidebar.h"
 #include "../base/Texture.h"
 #include "../base/Rectangle.h"
+#include "../base/Layout.h"
 #include "../base/Box.h"
 #include "../base/rect.h"
 
@@ -36,12 +37,15 @@ struct Sidebar
     OpenGLRenderer *renderer;
     const SceneGameRect *sceneGameRect;
     int width;
-    int player1_y;
-    int player1Win_y;
-    int player2_y;
-    int player2Win_y;
-    int tied_y;
-    int tiedCount_y;
+
+    Layout *layout;
+    Layout *panel;
+    Layout *verticalLineNode;
+    Layout *player1Block;
+    Layout *player2Block;
+    Layout *player1WinNode;
+    Layout *player2WinNode;
+    Layout *tiedCountNode;
 
     Rectangle *background;
     Rectangle *verticalLine;
@@ -59,8 +63,10 @@ struct Sidebar
 
 void Sidebar_SetupSizes(Sidebar * const self);
 void Sidebar_CreateTextures(Sidebar * const self);
-void Sidebar_UpdateTextRect(Sidebar * const self, Texture *texture, int y);
-void Sidebar_UpdateText(Sidebar * const self, Texture *texture, int pos_y, int count);
+void Sidebar_CreateLayout(Sidebar * const self);
+Layout *Sidebar_AddBlock(Sidebar * const self, Layout *panel, Texture *title, Texture *number, Layout **numberNode);
+Layout *Sidebar_AddLeaf(Layout *parent, Box *content);
+void Sidebar_UpdateText(Sidebar * const self, Texture *texture, Layout *node, int count);
 
 Sidebar *Sidebar_New(OpenGLRenderer *renderer, SceneGameRect *sceneGameRect)
 {
@@ -72,6 +78,7 @@ Sidebar *Sidebar_New(OpenGLRenderer *renderer, SceneGameRect *sceneGameRect)
 
     Sidebar_SetupSizes(self);
     Sidebar_CreateTextures(self);
+    Sidebar_CreateLayout(self);
 
     return self;
 }
@@ -81,6 +88,13 @@ void Sidebar_Delete(Sidebar * const self)
     if (!self)
         return;
 
+    Layout_Delete(self->layout);
+
+    Rectangle_Delete(self->background);
+    Rectangle_Delete(self->verticalLine);
+    Rectangle_Delete(self->horizontalLine1);
+    Rectangle_Delete(self->horizontalLine2);
+
     Texture_Delete(self->player1Text);
     Texture_Delete(self->player1WinText);
     Texture_Delete(self->player2Text);
@@ -108,36 +122,45 @@ void Sidebar_Draw(Sidebar * const self)
 
 void Sidebar_SetPlayer1WinText(Sidebar * const self, int count)
 {
-    Sidebar_UpdateText(self, self->player1WinText, self->player1Win_y, count);
+    Sidebar_UpdateText(self, self->player1WinText, self->player1WinNode, count);
 }
 
 void Sidebar_SetPlayer2WinText(Sidebar * const self, int count)
 {
-    Sidebar_UpdateText(self, self->player2WinText, self->player2Win_y, count);
+    Sidebar_UpdateText(self, self->player2WinText, self->player2WinNode, count);
 }
 
 void Sidebar_SetTiedCountText(Sidebar * const self, int count)
 {
-    Sidebar_UpdateText(self, self->tiedCountText, self->tiedCount_y, count);
+    Sidebar_UpdateText(self, self->tiedCountText, self->tiedCountNode, count);
+}
+
+void Sidebar_Resize(Sidebar * const self)
+{
+    // Three blocks of a third of the height, the horizontal lines take the bottom of the first two
+    const int block_h = self->sceneGameRect->sidebar_h / 3;
+    const int border_w = Box_Width(Rectangle_Box(self->verticalLine));
+
+    self->width = self->sceneGameRect->sidebar_w - border_w;
+
+    Box_SetSize(Rectangle_Box(self->background), self->width, self->sceneGameRect->sidebar_h);
+    Box_SetSize(Rectangle_Box(self->verticalLine), border_w, self->sceneGameRect->sidebar_h);
+    Box_SetSize(Rectangle_Box(self->horizontalLine1), self->width, border_w);
+    Box_SetSize(Rectangle_Box(self->horizontalLine2), self->width, border_w);
+
+    Layout_SetSize(self->panel, self->width, self->sceneGameRect->sidebar_h);
+    Layout_SetSize(self->player1Block, -1.f, block_h - border_w);
+    Layout_SetSize(self->player2Block, -1.f, block_h - border_w);
+    Layout_Invalidate(self->verticalLineNode);
+    Layout_Update(self->layout);
 }
 
 void Sidebar_SetupSizes(Sidebar * const self)
 {
     const int border_w = 2;
-    const int title_margin = 30;
-    const int number_margin = 75;
-    const int second_block = self->sceneGameRect->sidebar_h / 3;
-    const int third_block = second_block * 2;
 
     self->width = self->sceneGameRect->sidebar_w - border_w;
 
-    self->player1_y = title_margin;
-    self->player1Win_y = number_margin;
-    self->player2_y = second_block + title_margin;
-    self->player2Win_y = second_block + number_margin;
-    self->tied_y = third_block + title_margin;
-    self->tiedCount_y = third_block + number_margin;
-
     self->background = Rectangle_New(self->renderer, self->width, self->sceneGameRect->sidebar_h);
     self->verticalLine = Rectangle_New(self->renderer, border_w, self->sceneGameRect->sidebar_h);
     self->horizontalLine1 = Rectangle_New(self->renderer, self->width, border_w);
@@ -147,10 +170,6 @@ void Sidebar_SetupSizes(Sidebar * const self)
     Rectangle_SetColorRGBA(self->verticalLine, 80, 160, 160, 255);
     Rectangle_SetColorRGBA(self->horizontalLine1, 80, 160, 160, 255);
     Rectangle_SetColorRGBA(self->horizontalLine2, 80, 160, 160, 255);
-
-    Box_SetPosition(Rectangle_Box(self->verticalLine), self->width, 0);
-    Box_SetPosition(Rectangle_Box(self->horizontalLine1), 0, second_block - border_w);
-    Box_SetPosition(Rectangle_Box(self->horizontalLine2), 0, third_block - border_w);
 }
 
 void Sidebar_CreateTextures(Sidebar * const self)
@@ -189,32 +208,73 @@ void Sidebar_CreateTextures(Sidebar * const self)
     Texture_MakeText(self->player2WinText);
     Texture_MakeText(self->tiedText);
     Texture_MakeText(self->tiedCountText);
+}
+
+void Sidebar_CreateLayout(Sidebar * const self)
+{
+    // The blocks split by the horizontal lines, and the vertical line on the right
+    self->layout = Layout_New(Layout_Row);
 
-    Sidebar_UpdateTextRect(self, self->player1Text, self->player1_y);
-    Sidebar_UpdateTextRect(self, self->player1WinText, self->player1Win_y);
-    Sidebar_UpdateTextRect(self, self->player2Text, self->player2_y);
-    Sidebar_UpdateTextRect(self, self->player2WinText, self->player2Win_y);
-    Sidebar_UpdateTextRect(self, self->tiedText, self->tied_y);
-    Sidebar_UpdateTextRect(self, self->tiedCountText, self->tiedCount_y);
+    self->panel = Layout_New(Layout_Column);
+    Layout_SetAlign(self->panel, Layout_Stretch);
+    Layout_SetContent(self->panel, Rectangle_Box(self->background));
+    Layout_AddChild(self->layout, self->panel);
+
+    self->verticalLineNode = Sidebar_AddLeaf(self->layout, Rectangle_Box(self->verticalLine));
+
+    self->player1Block = Sidebar_AddBlock(self, self->panel, self->player1Text, self->player1WinText, &self->player1WinNode);
+    Sidebar_AddLeaf(self->panel, Rectangle_Box(self->horizontalLine1));
+
+    self->player2Block = Sidebar_AddBlock(self, self->panel, self->player2Text, self->player2WinText, &self->player2WinNode);
+    Sidebar_AddLeaf(self->panel, Rectangle_Box(self->horizontalLine2));
+
+    // The last block takes the rest, the height is not always divisible by three
+    Layout *block = Sidebar_AddBlock(self, self->panel, self->tiedText, self->tiedCountText, &self->tiedCountNode);
+    Layout_SetGrow(block, 1.f);
+
+    Sidebar_Resize(self);
 }
 
-void Sidebar_UpdateTextRect(Sidebar * const self, Texture *texture, int y)
+Layout *Sidebar_AddBlock(Sidebar * const self, Layout *panel, Texture *title, Texture *number, Layout **numberNode)
 {
     (void)self;
 
-    int w = Texture_GetWidth(texture);
-    int h = Texture_GetHeight(texture);
+    const float title_margin = 30.f;
+    const float number_margin = 75.f;
+
+    Layout *block = Layout_New(Layout_Column);
+    Layout_SetPadding(block, title_margin, 0.f, 0.f, 0.f);
+    Layout_SetAlign(block, Layout_Center);
+    Layout_AddChild(panel, block);
+
+    // The number starts at the same height whatever the size of the title
+    Layout *titleNode = Sidebar_AddLeaf(block, Texture_Box(title));
+    Layout_SetMinSize(titleNode, 0.f, number_margin - title_margin);
 
-    Box_SetSize(Texture_Box(texture), w, h);
-    Box_SetPosition(Texture_Box(texture), (self->width - w) / 2, y);
+    *numberNode = Sidebar_AddLeaf(block, Texture_Box(number));
+
+    return block;
 }
 
-void Sidebar_UpdateText(Sidebar * const self, Texture *texture, int pos_y, int count)
+Layout *Sidebar_AddLeaf(Layout *parent, Box *content)
+{
+    Layout *node = Layout_New(Layout_Row);
+
+    Layout_SetContent(node, content);
+    Layout_AddChild(parent, node);
+
+    return node;
+}
+
+void Sidebar_UpdateText(Sidebar * const self, Texture *texture, Layout *node, int count)
 {
     char text[6];
 
     snprintf(text, sizeof (text), "%d", count);
     Texture_SetText(texture, text);
     Texture_MakeText(texture);
-    Sidebar_UpdateTextRect(self, texture, pos_y);
+
+    // Only the block of the number is placed again
+    Layout_Invalidate(node);
+    Layout_Update(self->layout);
 }
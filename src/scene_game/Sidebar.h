@@ -36,3 +36,4 @@ void Sidebar_Draw(Sidebar * const self);
 void Sidebar_SetPlayer1WinText(Sidebar * const self, int count);
 void Sidebar_SetPlayer2WinText(Sidebar * const self, int count);
 void Sidebar_SetTiedCountText(Sidebar * const self, int count);
+void Sidebar_Resize(Sidebar * const self);
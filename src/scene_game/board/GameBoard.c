@@ -23,11 +23,14 @@ SOFTWARE.
 -------------------------------------------------------------------------------*/
 
 #include "GameBoard.h"
+#include "../../base/Animation.h"
 #include "../../base/Button.h"
 #include "../../base/Texture.h"
 #include "../../base/Rectangle.h"
+#include "../../base/Layout.h"
 #include "../../base/Box.h"
 #include "../../base/rect.h"
+#include "../../base/opengl_renderer/OpenGLRenderer.h"
 #include "board_util.h"
 
 #include <malloc.h>
@@ -41,7 +44,9 @@ typedef struct GameEvent
 struct GameBoard
 {
     OpenGLRenderer *renderer;
+    const SceneGameRect *sceneGameRect;
     Rectangle *background;
+    Layout *layout;
 
     Player player;
     Player gameResult;
@@ -49,7 +54,6 @@ struct GameBoard
 
     struct Board
     {
-        IRect rect;
         int item_size;
         int space;
         BoardItem items[3][3];
@@ -57,46 +61,58 @@ struct GameBoard
 
     GameEvent gameEvent;
 
+    // Ends of the three in a row, NULL until someone wins
+    BoardItem *winFrom;
+    BoardItem *winTo;
+
     Texture *player1Texture;
     Texture *player2Texture;
-
-    double p1Angle;
 };
 
 void GameBoard_SetupBoard(GameBoard * const self);
+void GameBoard_CreateLayout(GameBoard * const self);
 void GameBoard_OnItemPress(Button * const button, void *user);
 void GameBoard_Check(GameBoard * const self, BoardItem *item);
 Player GameBoard_CheckWinner(GameBoard * const self);
+void GameBoard_FindWinLine(GameBoard * const self);
+void GameBoard_DrawWinLine(GameBoard * const self);
+void GameBoard_OnTextureLoaded(Texture * const texture, bool loaded, void *userdata);
 
 GameBoard *GameBoard_New(OpenGLRenderer *renderer, SceneGameRect *sceneGameRect)
 {
     GameBoard * const self = malloc(sizeof (GameBoard));
 
-    const int board_size = 304;
-    int board_x = sceneGameRect->sidebar_w + ((sceneGameRect->content_w - board_size) / 2);
-    int board_y = (sceneGameRect->window_h - board_size) / 2;
-
     self->board.item_size = 98;
     self->board.space = 5;
-    self->board.rect = (IRect) {board_x, board_y, board_size, board_size};
+
+    const int board_size = (self->board.item_size * 3) + (self->board.space * 2);
 
     self->renderer = renderer;
+    self->sceneGameRect = sceneGameRect;
     self->background = Rectangle_New(self->renderer, board_size, board_size);
     self->player = Player_1;
     self->gameResult = None;
     self->round = 0;
     self->gameEvent = (GameEvent) {NULL, NULL};
+    self->winFrom = NULL;
+    self->winTo = NULL;
     self->player1Texture = Texture_New(renderer);
     self->player2Texture = Texture_New(renderer);
-    self->p1Angle = 0.0;
 
-    Box_SetPosition(Rectangle_Box(self->background), self->board.rect.x, self->board.rect.y);
     Rectangle_SetColorRGBA(self->background, 80, 160, 160, 255);
+    Rectangle_SetRadius(self->background, 10.f);
+
+    // Every player 1 icon shares the texture, so they all spin together without any update
+    Texture_SetAnimation(self->player1Texture, &(Animation) {.angularVelocity = 30.f});
+
+    Texture_SetOnLoadedEvent(self->player1Texture, GameBoard_OnTextureLoaded, self);
+    Texture_SetOnLoadedEvent(self->player2Texture, GameBoard_OnTextureLoaded, self);
 
     Texture_LoadImageFromFile(self->player1Texture, "images/player_1.png", Nearest);
     Texture_LoadImageFromFile(self->player2Texture, "images/player_2.png", Nearest);
 
     GameBoard_SetupBoard(self);
+    GameBoard_CreateLayout(self);
 
     return self;
 }
@@ -110,46 +126,38 @@ void GameBoard_Delete(GameBoard * const self)
         for (int j = 0; j < 3; ++j)
             Button_Delete(self->board.items[i][j].button);
 
+    Layout_Delete(self->layout);
+    Rectangle_Delete(self->background);
+
     Texture_Delete(self->player1Texture);
     Texture_Delete(self->player2Texture);
 
     free(self);
 }
 
-void GameBoard_ProcessEvent(GameBoard * const self, const SDL_Event *event)
+void GameBoard_SetInputRouter(GameBoard * const self, InputRouter *inputRouter)
 {
     for (int row = 0; row < 3; ++row)
         for (int col = 0; col < 3; ++col)
-            Button_ProcessEvent(self->board.items[row][col].button, event);
+            Button_SetInputRouter(self->board.items[row][col].button, inputRouter);
 }
 
-void GameBoard_Update(GameBoard * const self, double deltaTime)
+void GameBoard_Draw(GameBoard * const self)
 {
-    self->p1Angle = self->p1Angle + 30.0 * deltaTime;
-
-    if (self->p1Angle > 360.0)
-        self->p1Angle = 0.0;
+    Rectangle_Draw(self->background);
 
     for (int row = 0; row < 3; ++row)
-    {
         for (int col = 0; col < 3; ++col)
-        {
-            BoardItem *item = &self->board.items[row][col];
-            Texture *icon = Button_Icon(item->button);
+            Button_Draw(self->board.items[row][col].button);
 
-            if (icon)
-                Texture_SetAngle(icon, item->player == Player_1 ? self->p1Angle : 0);
-        }
-    }
+    GameBoard_DrawWinLine(self);
 }
 
-void GameBoard_Draw(GameBoard * const self)
+void GameBoard_Resize(GameBoard * const self)
 {
-    Rectangle_Draw(self->background);
-
-    for (int row = 0; row < 3; ++row)
-        for (int col = 0; col < 3; ++col)
-            Button_Draw(self->board.items[row][col].button);
+    Layout_SetPosition(self->layout, self->sceneGameRect->sidebar_w, 0);
+    Layout_SetSize(self->layout, self->sceneGameRect->content_w, self->sceneGameRect->window_h);
+    Layout_Update(self->layout);
 }
 
 void GameBoard_SetGameEvent(GameBoard * const self, GameEventHandler callback, void *user)
@@ -178,14 +186,12 @@ void GameBoard_SetupBoard(GameBoard * const self)
             *item = (BoardItem) {.player = 0, .button = Button_New(self->renderer)};
 
             Box_SetSize(Button_Box(item->button), self->board.item_size, self->board.item_size);
-            Box_SetPosition(Button_Box(item->button),
-                            self->board.rect.x + (col * self->board.item_size) + (col * self->board.space),
-                            self->board.rect.y + (row * self->board.item_size) + (row * self->board.space));
 
             Button_SetOnPressEvent(item->button, GameBoard_OnItemPress, self);
             Button_SetBackgroundColorRGB(item->button, 210, 240, 240);
             Button_SetBackgroundHoverColorRGB(item->button, 225, 255, 255);
             Button_SetBackgroundPressedColorRGB(item->button, 180, 230, 230);
+            Button_SetBackgroundRadius(item->button, 8.f);
         }
     }
 }
@@ -219,6 +225,9 @@ void GameBoard_Check(GameBoard * const self, BoardItem *item)
     self->gameResult = GameBoard_CheckWinner(self);
     self->player = self->player == Player_1 ? Player_2 : Player_1;
 
+    if (self->gameResult == Player_1 || self->gameResult == Player_2)
+        GameBoard_FindWinLine(self);
+
     if (self->gameEvent.function)
         self->gameEvent.function(self, self->gameEvent.userdata);
 
@@ -249,3 +258,90 @@ Player GameBoard_CheckWinner(GameBoard * const self)
 
     return None;
 }
+
+void GameBoard_FindWinLine(GameBoard * const self)
+{
+    // Rows, columns and both diagonals, as the row and column of their first cell and the step to the next
+    static const int lines[8][4] = {
+        {0, 0, 0, 1}, {1, 0, 0, 1}, {2, 0, 0, 1},
+        {0, 0, 1, 0}, {0, 1, 1, 0}, {0, 2, 1, 0},
+        {0, 0, 1, 1}, {0, 2, 1, -1},
+    };
+
+    for (int i = 0; i < 8; ++i)
+    {
+        const int *line = lines[i];
+        BoardItem *first = &self->board.items[line[0]][line[1]];
+        BoardItem *second = &self->board.items[line[0] + line[2]][line[1] + line[3]];
+        BoardItem *third = &self->board.items[line[0] + line[2] * 2][line[1] + line[3] * 2];
+
+        if (first->player == self->gameResult && second->player == first->player && third->player == first->player)
+        {
+            self->winFrom = first;
+            self->winTo = third;
+            return;
+        }
+    }
+}
+
+void GameBoard_DrawWinLine(GameBoard * const self)
+{
+    if (!self->winFrom)
+        return;
+
+    const Rect *from = Box_Rect(Button_Box(self->winFrom->button));
+    const Rect *to = Box_Rect(Button_Box(self->winTo->button));
+    const Color color = {30, 120, 120, 220};
+
+    OpenGLRenderer_DrawLine(self->renderer, from->x + from->w / 2.f, from->y + from->h / 2.f,
+                            to->x + to->w / 2.f, to->y + to->h / 2.f, 8.f, &color);
+}
+
+void GameBoard_OnTextureLoaded(Texture * const texture, bool loaded, void *userdata)
+{
+    (void)loaded;
+
+    GameBoard * const self = userdata;
+
+    // Items played before the upload finished still have the placeholder size
+    for (int row = 0; row < 3; ++row)
+    {
+        for (int col = 0; col < 3; ++col)
+        {
+            BoardItem *item = &self->board.items[row][col];
+            Player player = texture == self->player1Texture ? Player_1 : Player_2;
+
+            if (item->player == player)
+                Button_SetIcon(item->button, texture);
+        }
+    }
+}
+
+void GameBoard_CreateLayout(GameBoard * const self)
+{
+    // The board is centered in the content, the items are rows of buttons inside it
+    self->layout = Layout_New(Layout_Column);
+    Layout_SetJustify(self->layout, Layout_Center);
+    Layout_SetAlign(self->layout, Layout_Center);
+
+    Layout *board = Layout_New(Layout_Column);
+    Layout_SetContent(board, Rectangle_Box(self->background));
+    Layout_SetGap(board, self->board.space);
+    Layout_AddChild(self->layout, board);
+
+    for (int row = 0; row < 3; ++row)
+    {
+        Layout *line = Layout_New(Layout_Row);
+        Layout_SetGap(line, self->board.space);
+        Layout_AddChild(board, line);
+
+        for (int col = 0; col < 3; ++col)
+        {
+            Layout *item = Layout_New(Layout_Row);
+            Layout_SetContent(item, Button_Box(self->board.items[row][col].button));
+            Layout_AddChild(line, item);
+        }
+    }
+
+    GameBoard_Resize(self);
+}
@@ -26,18 +26,17 @@ SOFTWARE.
 
 #include "../SceneGameRect.h"
 
-typedef union SDL_Event SDL_Event;
-
 typedef struct OpenGLRenderer OpenGLRenderer;
+typedef struct InputRouter InputRouter;
 typedef struct GameBoard GameBoard;
 
 typedef void (*GameEventHandler)(GameBoard * const game, void *user);
 
 GameBoard *GameBoard_New(OpenGLRenderer *renderer, SceneGameRect *sceneGameRect);
 void GameBoard_Delete(GameBoard * const self);
-void GameBoard_ProcessEvent(GameBoard * const self, const SDL_Event *event);
-void GameBoard_Update(GameBoard * const self, double deltaTime);
+void GameBoard_SetInputRouter(GameBoard * const self, InputRouter *inputRouter);
 void GameBoard_Draw(GameBoard * const self);
+void GameBoard_Resize(GameBoard * const self);
 void GameBoard_SetGameEvent(GameBoard * const self, GameEventHandler callback, void *user);
 int GameBoard_GetCurrentPlayer(GameBoard * const self);
 int GameBoard_GetGameResult(GameBoard * const self);
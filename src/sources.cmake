@@ -15,25 +15,69 @@ set(SRC_FILES
     src/base/Rectangle.h
     src/base/Box.h
     src/base/Box.c
+    src/base/Layout.h
+    src/base/Layout.c
+    src/base/Tween.h
+    src/base/Tween.c
+    src/base/ParticleSystem.h
+    src/base/ParticleSystem.c
     src/base/SceneManager.h
     src/base/SceneManager.c
+    src/base/InputRouter.h
+    src/base/InputRouter.c
+    src/base/InputLogFormat.h
+    src/base/InputRecorder.h
+    src/base/InputRecorder.c
+    src/base/InputReplay.h
+    src/base/InputReplay.c
+    src/base/FrameStats.h
+    src/base/FrameStats.c
+    src/base/Snapshot.h
+    src/base/Snapshot.c
+    src/base/DynamicResolution.h
+    src/base/DynamicResolution.c
     src/base/DataZipFile.h
     src/base/DataZipFile.c
+    src/base/DataPackFormat.h
+    src/base/CookedImageFormat.h
+    src/base/AssetLoader.h
+    src/base/AssetLoader.c
+    src/base/AssetWatcher.h
+    src/base/AssetWatcher.c
     src/base/LinkedList.h
     src/base/LinkedList.c
+    src/base/IntrusiveList.h
+    src/base/Pool.h
+    src/base/Pool.c
+    src/base/Vector.h
     src/base/rect.h
+    src/base/Animation.h
     src/base/TextureFilter.h
     src/base/private/Timer.h
     src/base/private/Timer.c
     src/base/opengl_renderer/GL.h
     src/base/opengl_renderer/GLProgram.h
     src/base/opengl_renderer/GLProgram.c
+    src/base/opengl_renderer/GLProgramCache.h
+    src/base/opengl_renderer/GLProgramCache.c
     src/base/opengl_renderer/OpenGLRenderer.c
     src/base/opengl_renderer/OpenGLRenderer.h
     src/base/opengl_renderer/GLBuffer.h
     src/base/opengl_renderer/GLBuffer.c
+    src/base/opengl_renderer/GLStreamBuffer.h
+    src/base/opengl_renderer/GLStreamBuffer.c
+    src/base/opengl_renderer/GLExtensions.h
+    src/base/opengl_renderer/GLExtensions.c
+    src/base/opengl_renderer/GLState.h
+    src/base/opengl_renderer/GLState.c
     src/base/opengl_renderer/GLTexture.h
     src/base/opengl_renderer/GLTexture.c
+    src/base/opengl_renderer/GLFramebuffer.h
+    src/base/opengl_renderer/GLFramebuffer.c
+    src/base/opengl_renderer/GLGpuTimer.h
+    src/base/opengl_renderer/GLGpuTimer.c
+    src/base/opengl_renderer/GLUniformBuffer.h
+    src/base/opengl_renderer/GLUniformBuffer.c
     src/scene_game/SceneGameRect.h
     src/scene_game/SceneGame.c
     src/scene_game/SceneGame.h
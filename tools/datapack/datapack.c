@@ -0,0 +1,327 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+// Builds data.pack from the assets directory:
+//   datapack [--lz4] <assets dir> <output file>
+// Without --lz4 every file is stored as is and the game reads it straight from the mapping
+
+#include "DataPackFormat.h"
+
+#include <dirent.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define MAX_FILES 1024
+#define MAX_PATH_LENGTH 512
+
+typedef struct File
+{
+    char name[MAX_PATH_LENGTH];
+    unsigned char *data;
+    uint32_t size;
+    uint32_t originalSize;
+    DataPackCompression compression;
+} File;
+
+static File files[MAX_FILES];
+static int filesCount = 0;
+
+static void AddDirectory(const char *root, const char *relative);
+static unsigned char *ReadFile(const char *path, uint32_t *size);
+static uint32_t CompressLZ4(const unsigned char *src, uint32_t srcSize, unsigned char *dst);
+static int CompareFiles(const void *a, const void *b);
+static void WritePadding(FILE *file, long alignment);
+
+int main(int argc, char *argv[])
+{
+    bool lz4 = argc == 4 && strcmp(argv[1], "--lz4") == 0;
+
+    if (argc != 3 && !lz4)
+    {
+        puts("Usage: datapack [--lz4] <assets dir> <output file>");
+        return EXIT_FAILURE;
+    }
+
+    const char *root = argv[argc - 2];
+    const char *output = argv[argc - 1];
+
+    AddDirectory(root, "");
+    qsort(files, filesCount, sizeof (File), CompareFiles);
+
+    for (int i = 0; lz4 && i < filesCount; ++i)
+    {
+        File *file = &files[i];
+
+        // Worst case of LZ4 for incompressible data
+        unsigned char *compressed = malloc(file->size + file->size / 255 + 16);
+        uint32_t size = CompressLZ4(file->data, file->size, compressed);
+
+        // Already compressed data (PNG) stays stored, so it keeps the zero-copy path
+        if (size < file->size - file->size / 8)
+        {
+            free(file->data);
+            file->data = compressed;
+            file->size = size;
+            file->compression = Compression_LZ4;
+        }
+        else
+        {
+            free(compressed);
+        }
+    }
+
+    FILE *out = fopen(output, "wb");
+
+    if (!out)
+    {
+        printf("Unable to create %s\n", output);
+        return EXIT_FAILURE;
+    }
+
+    DataPackHeader header = {
+        .magic = DATA_PACK_MAGIC,
+        .version = DATA_PACK_VERSION,
+        .count = filesCount,
+        .namesOffset = sizeof (DataPackHeader) + filesCount * sizeof (DataPackEntry),
+    };
+
+    uint32_t namesSize = 0;
+
+    for (int i = 0; i < filesCount; ++i)
+        namesSize += strlen(files[i].name);
+
+    uint64_t offset = header.namesOffset + namesSize;
+    uint32_t nameOffset = 0;
+
+    fwrite(&header, sizeof (header), 1, out);
+
+    for (int i = 0; i < filesCount; ++i)
+    {
+        offset = (offset + DATA_PACK_ALIGNMENT - 1) & ~(uint64_t) (DATA_PACK_ALIGNMENT - 1);
+
+        const DataPackEntry entry = {
+            .offset = offset,
+            .size = files[i].size,
+            .originalSize = files[i].originalSize,
+            .nameOffset = nameOffset,
+            .nameLength = strlen(files[i].name),
+            .compression = files[i].compression,
+        };
+
+        fwrite(&entry, sizeof (entry), 1, out);
+
+        offset += entry.size;
+        nameOffset += entry.nameLength;
+    }
+
+    for (int i = 0; i < filesCount; ++i)
+        fwrite(files[i].name, strlen(files[i].name), 1, out);
+
+    for (int i = 0; i < filesCount; ++i)
+    {
+        WritePadding(out, DATA_PACK_ALIGNMENT);
+        fwrite(files[i].data, files[i].size, 1, out);
+
+        printf("%-40s %8u -> %8u%s\n", files[i].name, files[i].originalSize, files[i].size,
+               files[i].compression == Compression_LZ4 ? " (lz4)" : "");
+
+        free(files[i].data);
+    }
+
+    fclose(out);
+
+    return EXIT_SUCCESS;
+}
+
+void AddDirectory(const char *root, const char *relative)
+{
+    char path[MAX_PATH_LENGTH];
+    snprintf(path, sizeof (path), "%s/%s", root, relative);
+
+    DIR *dir = opendir(path);
+
+    if (!dir)
+    {
+        printf("Unable to open %s\n", path);
+        exit(EXIT_FAILURE);
+    }
+
+    for (struct dirent *item; (item = readdir(dir));)
+    {
+        if (item->d_name[0] == '.')
+            continue;
+
+        char name[MAX_PATH_LENGTH];
+        snprintf(name, sizeof (name), "%s%s", relative, item->d_name);
+        snprintf(path, sizeof (path), "%s/%s", root, name);
+
+        struct stat st;
+
+        if (stat(path, &st) == -1)
+            continue;
+
+        if (S_ISDIR(st.st_mode))
+        {
+            strcat(name, "/");
+            AddDirectory(root, name);
+            continue;
+        }
+
+        if (filesCount == MAX_FILES)
+        {
+            puts("Too many files");
+            exit(EXIT_FAILURE);
+        }
+
+        File *file = &files[filesCount++];
+
+        strcpy(file->name, name);
+        file->data = ReadFile(path, &file->size);
+        file->originalSize = file->size;
+        file->compression = Compression_None;
+    }
+
+    closedir(dir);
+}
+
+unsigned char *ReadFile(const char *path, uint32_t *size)
+{
+    FILE *file = fopen(path, "rb");
+
+    if (!file)
+    {
+        printf("Unable to read %s\n", path);
+        exit(EXIT_FAILURE);
+    }
+
+    fseek(file, 0, SEEK_END);
+    *size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    unsigned char *data = malloc(*size ? *size : 1);
+
+    if (fread(data, 1, *size, file) != *size)
+    {
+        printf("Unable to read %s\n", path);
+        exit(EXIT_FAILURE);
+    }
+
+    fclose(file);
+
+    return data;
+}
+
+static unsigned char *WriteLength(unsigned char *op, uint32_t length)
+{
+    for (; length >= 255; length -= 255)
+        *op++ = 255;
+
+    *op++ = length;
+
+    return op;
+}
+
+uint32_t CompressLZ4(const unsigned char *src, uint32_t srcSize, unsigned char *dst)
+{
+    // Greedy LZ4 block compressor, one candidate per hash slot
+    enum { HashBits = 16, MinMatch = 4, LastLiterals = 5, MatchLimit = 12 };
+
+    static uint32_t table[1 << HashBits];
+    memset(table, 0xff, sizeof (table));
+
+    unsigned char *op = dst;
+    uint32_t anchor = 0;
+    uint32_t ip = 0;
+
+    while (srcSize >= MatchLimit && ip + MatchLimit <= srcSize)
+    {
+        uint32_t sequence;
+        memcpy(&sequence, src + ip, sizeof (sequence));
+
+        const uint32_t hash = (sequence * 2654435761u) >> (32 - HashBits);
+        const uint32_t candidate = table[hash];
+        table[hash] = ip;
+
+        if (candidate == 0xffffffff || ip - candidate > 0xffff || memcmp(src + candidate, src + ip, MinMatch) != 0)
+        {
+            ++ip;
+            continue;
+        }
+
+        uint32_t length = MinMatch;
+
+        while (ip + length < srcSize - LastLiterals && src[candidate + length] == src[ip + length])
+            ++length;
+
+        const uint32_t literals = ip - anchor;
+        unsigned char *token = op++;
+
+        *token = (literals >= 15 ? 15 : literals) << 4;
+
+        if (literals >= 15)
+            op = WriteLength(op, literals - 15);
+
+        memcpy(op, src + anchor, literals);
+        op += literals;
+
+        const uint32_t offset = ip - candidate;
+        *op++ = offset & 0xff;
+        *op++ = offset >> 8;
+
+        const uint32_t matchLength = length - MinMatch;
+        *token |= matchLength >= 15 ? 15 : matchLength;
+
+        if (matchLength >= 15)
+            op = WriteLength(op, matchLength - 15);
+
+        ip += length;
+        anchor = ip;
+    }
+
+    const uint32_t literals = srcSize - anchor;
+    *op++ = (literals >= 15 ? 15 : literals) << 4;
+
+    if (literals >= 15)
+        op = WriteLength(op, literals - 15);
+
+    memcpy(op, src + anchor, literals);
+    op += literals;
+
+    return op - dst;
+}
+
+int CompareFiles(const void *a, const void *b)
+{
+    // Same order as the binary search in DataZipFile.c
+    return strcmp(((const File *) a)->name, ((const File *) b)->name);
+}
+
+void WritePadding(FILE *file, long alignment)
+{
+    for (long position = ftell(file); position % alignment != 0; ++position)
+        fputc(0, file);
+}
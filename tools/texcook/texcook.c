@@ -0,0 +1,692 @@
+//-------------------------------------------------------------------------------
+// Copyright (c) 2020-2022 Fábio Pichler
+/*-------------------------------------------------------------------------------
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-------------------------------------------------------------------------------*/
+
+// Cooks a PNG into a GPU-ready .tex: RGBA8 in R, G, B, A byte order, or compressed to ETC2 (RGBA8 EAC)
+// or S3TC (DXT5), plus the full mipmap chain
+//   texcook [--no-mipmaps] [--format rgba8|etc2|s3tc] <input.png> <output.tex>
+
+#include "CookedImageFormat.h"
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct Level
+{
+    int width;
+    int height;
+    unsigned char *pixels;
+} Level;
+
+static const int EtcModifiers[8][4] = {
+    {2, 8, -2, -8},
+    {5, 17, -5, -17},
+    {9, 29, -9, -29},
+    {13, 42, -13, -42},
+    {18, 60, -18, -60},
+    {24, 80, -24, -80},
+    {33, 106, -33, -106},
+    {47, 183, -47, -183},
+};
+
+static const int EacModifiers[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14},
+    {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12},
+    {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11},
+    {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10},
+    {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},
+    {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},
+    {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},
+    {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},
+    {-3, -5, -7, -9, 2, 4, 6, 8},
+};
+
+static void Downsample(const Level *src, Level *dst);
+static void WriteLevel(FILE *file, const Level *level, CookedImageFormat format);
+static void FetchBlock(const Level *level, int bx, int by, unsigned char block[16][4]);
+static void EncodeETC2Block(const unsigned char block[16][4], unsigned char *out);
+static void EncodeS3TCBlock(const unsigned char block[16][4], unsigned char *out);
+static int Clamp255(int value);
+static void WriteBigEndian(uint64_t bits, unsigned char *out);
+static int Weight(const unsigned char *texel);
+static void EncodeEACAlpha(const unsigned char block[16][4], unsigned char *out);
+static bool InSubblock(int x, int y, bool flip, int subblock);
+static void AverageSubblock(const unsigned char block[16][4], bool flip, int subblock, int average[3]);
+static unsigned FitSubblock(const unsigned char block[16][4], bool flip, int subblock, const int base[3], int *table, int indices[16]);
+static void EncodeETC2Color(const unsigned char block[16][4], unsigned char *out);
+static void EncodeDXT5Alpha(const unsigned char block[16][4], unsigned char *out);
+static uint16_t To565(const unsigned char *color);
+static void From565(uint16_t color, int out[3]);
+static void EncodeDXT5Color(const unsigned char block[16][4], unsigned char *out);
+
+int main(int argc, char *argv[])
+{
+    bool noMipmaps = false;
+    CookedImageFormat format = CookedFormat_RGBA8;
+    int arg = 1;
+
+    for (; arg < argc - 2; ++arg)
+    {
+        if (strcmp(argv[arg], "--no-mipmaps") == 0)
+            noMipmaps = true;
+        else if (strcmp(argv[arg], "--format") == 0 && arg + 1 < argc - 2)
+            format = strcmp(argv[++arg], "etc2") == 0 ? CookedFormat_ETC2_RGBA8
+                   : strcmp(argv[arg], "s3tc") == 0 ? CookedFormat_S3TC_DXT5
+                   : strcmp(argv[arg], "rgba8") == 0 ? CookedFormat_RGBA8
+                   : (CookedImageFormat) -1;
+        else
+            break;
+    }
+
+    if (arg != argc - 2 || (int) format < 0)
+    {
+        puts("Usage: texcook [--no-mipmaps] [--format rgba8|etc2|s3tc] <input.png> <output.tex>");
+        return EXIT_FAILURE;
+    }
+
+    const char *input = argv[argc - 2];
+    const char *output = argv[argc - 1];
+
+    SDL_Surface *loaded = IMG_Load(input);
+
+    if (!loaded)
+    {
+        printf("Unable to load %s: %s\n", input, IMG_GetError());
+        return EXIT_FAILURE;
+    }
+
+    // Swizzled here once instead of by GetFormat and the BGRA shader on every launch
+    SDL_Surface *surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(loaded);
+
+    if (!surface)
+    {
+        printf("Unable to convert %s: %s\n", input, SDL_GetError());
+        return EXIT_FAILURE;
+    }
+
+    Level levels[COOKED_IMAGE_MAX_LEVELS];
+    int levelsCount = 1;
+
+    levels[0].width = surface->w;
+    levels[0].height = surface->h;
+    levels[0].pixels = malloc(surface->w * surface->h * 4);
+
+    for (int y = 0; y < surface->h; ++y)
+        memcpy(levels[0].pixels + y * surface->w * 4, (unsigned char *) surface->pixels + y * surface->pitch, surface->w * 4);
+
+    SDL_FreeSurface(surface);
+
+    // WebGL only takes compressed levels that are a multiple of the block size, or smaller than it
+    const bool powerOfTwo = !(levels[0].width & (levels[0].width - 1)) && !(levels[0].height & (levels[0].height - 1));
+
+    if (!noMipmaps && format != CookedFormat_RGBA8 && !powerOfTwo)
+    {
+        printf("%s: compressed mipmaps need a power of two size, writing only the base level\n", input);
+        noMipmaps = true;
+    }
+
+    while (!noMipmaps && levelsCount < COOKED_IMAGE_MAX_LEVELS
+           && (levels[levelsCount - 1].width > 1 || levels[levelsCount - 1].height > 1))
+    {
+        Downsample(&levels[levelsCount - 1], &levels[levelsCount]);
+        ++levelsCount;
+    }
+
+    FILE *file = fopen(output, "wb");
+
+    if (!file)
+    {
+        printf("Unable to create %s\n", output);
+        return EXIT_FAILURE;
+    }
+
+    const CookedImageHeader header = {
+        .magic = COOKED_IMAGE_MAGIC,
+        .version = COOKED_IMAGE_VERSION,
+        .format = format,
+        .width = levels[0].width,
+        .height = levels[0].height,
+        .levels = levelsCount,
+    };
+
+    fwrite(&header, sizeof (header), 1, file);
+
+    for (int i = 0; i < levelsCount; ++i)
+    {
+        WriteLevel(file, &levels[i], format);
+        free(levels[i].pixels);
+    }
+
+    fclose(file);
+
+    printf("%s: %dx%d, %d levels\n", output, header.width, header.height, levelsCount);
+
+    return EXIT_SUCCESS;
+}
+
+void Downsample(const Level *src, Level *dst)
+{
+    dst->width = src->width > 1 ? src->width / 2 : 1;
+    dst->height = src->height > 1 ? src->height / 2 : 1;
+    dst->pixels = malloc(dst->width * dst->height * 4);
+
+    for (int y = 0; y < dst->height; ++y)
+    {
+        for (int x = 0; x < dst->width; ++x)
+        {
+            unsigned int color[3] = {0, 0, 0};
+            unsigned int alpha = 0;
+
+            // 2x2 box, weighted by alpha so transparent texels don't darken the edges
+            for (int i = 0; i < 4; ++i)
+            {
+                const int sx = x * 2 + (i & 1) < src->width ? x * 2 + (i & 1) : src->width - 1;
+                const int sy = y * 2 + (i >> 1) < src->height ? y * 2 + (i >> 1) : src->height - 1;
+                const unsigned char *texel = src->pixels + (sy * src->width + sx) * 4;
+
+                for (int c = 0; c < 3; ++c)
+                    color[c] += texel[c] * texel[3];
+
+                alpha += texel[3];
+            }
+
+            unsigned char *out = dst->pixels + (y * dst->width + x) * 4;
+
+            for (int c = 0; c < 3; ++c)
+                out[c] = alpha ? (color[c] + alpha / 2) / alpha : 0;
+
+            out[3] = (alpha + 2) / 4;
+        }
+    }
+}
+
+void WriteLevel(FILE *file, const Level *level, CookedImageFormat format)
+{
+    const uint32_t size = CookedImage_LevelSize(format, level->width, level->height);
+    const uint32_t padding = 0;
+
+    fwrite(&size, sizeof (size), 1, file);
+
+    if (format == CookedFormat_RGBA8)
+    {
+        fwrite(level->pixels, size, 1, file);
+    }
+    else
+    {
+        for (int by = 0; by < (level->height + 3) / 4; ++by)
+        {
+            for (int bx = 0; bx < (level->width + 3) / 4; ++bx)
+            {
+                unsigned char block[16][4];
+                unsigned char out[16];
+
+                FetchBlock(level, bx, by, block);
+
+                if (format == CookedFormat_ETC2_RGBA8)
+                    EncodeETC2Block(block, out);
+                else
+                    EncodeS3TCBlock(block, out);
+
+                fwrite(out, sizeof (out), 1, file);
+            }
+        }
+    }
+
+    fwrite(&padding, (4 - size % 4) % 4, 1, file);
+}
+
+void FetchBlock(const Level *level, int bx, int by, unsigned char block[16][4])
+{
+    // Edge texels are repeated to fill the blocks past the border
+    for (int y = 0; y < 4; ++y)
+    {
+        for (int x = 0; x < 4; ++x)
+        {
+            const int sx = bx * 4 + x < level->width ? bx * 4 + x : level->width - 1;
+            const int sy = by * 4 + y < level->height ? by * 4 + y : level->height - 1;
+
+            memcpy(block[y * 4 + x], level->pixels + (sy * level->width + sx) * 4, 4);
+        }
+    }
+}
+
+int Clamp255(int value)
+{
+    return value < 0 ? 0 : value > 255 ? 255 : value;
+}
+
+void WriteBigEndian(uint64_t bits, unsigned char *out)
+{
+    for (int i = 0; i < 8; ++i)
+        out[i] = bits >> (56 - i * 8);
+}
+
+// Transparent texels still count a little, so their color doesn't drift too far when filtered
+int Weight(const unsigned char *texel)
+{
+    return 1 + texel[3];
+}
+
+void EncodeEACAlpha(const unsigned char block[16][4], unsigned char *out)
+{
+    int min = 255, max = 0;
+
+    for (int i = 0; i < 16; ++i)
+    {
+        min = block[i][3] < min ? block[i][3] : min;
+        max = block[i][3] > max ? block[i][3] : max;
+    }
+
+    unsigned bestError = ~0u;
+    int bestBase = max, bestMultiplier = 1, bestTable = 13;
+
+    // Table 13 has a zero modifier, a flat block is exact with it
+    if (min != max)
+    {
+        const int center = (min + max + 1) / 2;
+
+        for (int table = 0; table < 16; ++table)
+        {
+            for (int multiplier = 1; multiplier < 16; ++multiplier)
+            {
+                for (int base = center - 12 < 0 ? 0 : center - 12; base <= center + 12 && base < 256; ++base)
+                {
+                    unsigned error = 0;
+
+                    for (int i = 0; i < 16 && error < bestError; ++i)
+                    {
+                        unsigned best = ~0u;
+
+                        for (int m = 0; m < 8; ++m)
+                        {
+                            const int diff = Clamp255(base + EacModifiers[table][m] * multiplier) - block[i][3];
+                            best = (unsigned) (diff * diff) < best ? (unsigned) (diff * diff) : best;
+                        }
+
+                        error += best;
+                    }
+
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        bestBase = base;
+                        bestMultiplier = multiplier;
+                        bestTable = table;
+                    }
+                }
+            }
+        }
+    }
+
+    uint64_t bits = (uint64_t) bestBase << 56 | (uint64_t) bestMultiplier << 52 | (uint64_t) bestTable << 48;
+
+    // Indices go down the columns
+    for (int x = 0; x < 4; ++x)
+    {
+        for (int y = 0; y < 4; ++y)
+        {
+            const int alpha = block[y * 4 + x][3];
+            int index = 0, best = 1 << 30;
+
+            for (int m = 0; m < 8; ++m)
+            {
+                const int diff = Clamp255(bestBase + EacModifiers[bestTable][m] * bestMultiplier) - alpha;
+
+                if (diff * diff < best)
+                {
+                    best = diff * diff;
+                    index = m;
+                }
+            }
+
+            bits |= (uint64_t) index << (45 - (x * 4 + y) * 3);
+        }
+    }
+
+    WriteBigEndian(bits, out);
+}
+
+bool InSubblock(int x, int y, bool flip, int subblock)
+{
+    return (flip ? y >= 2 : x >= 2) == (subblock == 1);
+}
+
+void AverageSubblock(const unsigned char block[16][4], bool flip, int subblock, int average[3])
+{
+    int sum[3] = {0, 0, 0}, weights = 0;
+
+    for (int y = 0; y < 4; ++y)
+    {
+        for (int x = 0; x < 4; ++x)
+        {
+            if (!InSubblock(x, y, flip, subblock))
+                continue;
+
+            const unsigned char *texel = block[y * 4 + x];
+
+            for (int c = 0; c < 3; ++c)
+                sum[c] += texel[c] * Weight(texel);
+
+            weights += Weight(texel);
+        }
+    }
+
+    for (int c = 0; c < 3; ++c)
+        average[c] = (sum[c] + weights / 2) / weights;
+}
+
+// Picks the modifier table for a subblock around base, returns the weighted error
+unsigned FitSubblock(const unsigned char block[16][4], bool flip, int subblock, const int base[3], int *table, int indices[16])
+{
+    unsigned bestError = ~0u;
+
+    for (int t = 0; t < 8; ++t)
+    {
+        unsigned error = 0;
+        int chosen[16];
+
+        for (int y = 0; y < 4; ++y)
+        {
+            for (int x = 0; x < 4; ++x)
+            {
+                if (!InSubblock(x, y, flip, subblock))
+                    continue;
+
+                const unsigned char *texel = block[y * 4 + x];
+                unsigned best = ~0u;
+
+                for (int m = 0; m < 4; ++m)
+                {
+                    unsigned distance = 0;
+
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        const int diff = Clamp255(base[c] + EtcModifiers[t][m]) - texel[c];
+                        distance += diff * diff;
+                    }
+
+                    if (distance < best)
+                    {
+                        best = distance;
+                        chosen[x * 4 + y] = m;
+                    }
+                }
+
+                error += best * Weight(texel);
+            }
+        }
+
+        if (error < bestError)
+        {
+            bestError = error;
+            *table = t;
+
+            for (int y = 0; y < 4; ++y)
+                for (int x = 0; x < 4; ++x)
+                    if (InSubblock(x, y, flip, subblock))
+                        indices[x * 4 + y] = chosen[x * 4 + y];
+        }
+    }
+
+    return bestError;
+}
+
+void EncodeETC2Color(const unsigned char block[16][4], unsigned char *out)
+{
+    // Only the ETC1 compatible individual and differential modes
+    uint64_t bestBits = 0;
+    unsigned bestError = ~0u;
+
+    for (int flip = 0; flip < 2; ++flip)
+    {
+        int averages[2][3];
+        AverageSubblock(block, flip, 0, averages[0]);
+        AverageSubblock(block, flip, 1, averages[1]);
+
+        for (int differential = 0; differential < 2; ++differential)
+        {
+            int quantized[2][3], bases[2][3];
+
+            for (int s = 0; s < 2; ++s)
+            {
+                for (int c = 0; c < 3; ++c)
+                {
+                    if (differential)
+                    {
+                        quantized[s][c] = (averages[s][c] * 31 + 127) / 255;
+                        bases[s][c] = quantized[s][c] << 3 | quantized[s][c] >> 2;
+                    }
+                    else
+                    {
+                        quantized[s][c] = (averages[s][c] * 15 + 127) / 255;
+                        bases[s][c] = quantized[s][c] << 4 | quantized[s][c];
+                    }
+                }
+            }
+
+            if (differential)
+            {
+                bool fits = true;
+
+                for (int c = 0; c < 3; ++c)
+                    fits = fits && quantized[1][c] - quantized[0][c] >= -4 && quantized[1][c] - quantized[0][c] <= 3;
+
+                if (!fits)
+                    continue;
+            }
+
+            int tables[2], indices[16];
+            const unsigned error = FitSubblock(block, flip, 0, bases[0], &tables[0], indices)
+                                 + FitSubblock(block, flip, 1, bases[1], &tables[1], indices);
+
+            if (error >= bestError)
+                continue;
+
+            uint64_t bits = 0;
+
+            for (int c = 0; c < 3; ++c)
+            {
+                if (differential)
+                    bits |= (uint64_t) quantized[0][c] << (59 - c * 8) | (uint64_t) ((quantized[1][c] - quantized[0][c]) & 7) << (56 - c * 8);
+                else
+                    bits |= (uint64_t) quantized[0][c] << (60 - c * 8) | (uint64_t) quantized[1][c] << (56 - c * 8);
+            }
+
+            bits |= (uint64_t) tables[0] << 37 | (uint64_t) tables[1] << 34 | (uint64_t) differential << 33 | (uint64_t) flip << 32;
+
+            // Modifier m is stored as its high bit in the upper half and its low bit in the lower one
+            for (int i = 0; i < 16; ++i)
+                bits |= (uint64_t) (indices[i] >> 1) << (16 + i) | (uint64_t) (indices[i] & 1) << i;
+
+            bestError = error;
+            bestBits = bits;
+        }
+    }
+
+    WriteBigEndian(bestBits, out);
+}
+
+void EncodeETC2Block(const unsigned char block[16][4], unsigned char *out)
+{
+    EncodeEACAlpha(block, out);
+    EncodeETC2Color(block, out + 8);
+}
+
+void EncodeDXT5Alpha(const unsigned char block[16][4], unsigned char *out)
+{
+    int min = 255, max = 0;
+
+    for (int i = 0; i < 16; ++i)
+    {
+        min = block[i][3] < min ? block[i][3] : min;
+        max = block[i][3] > max ? block[i][3] : max;
+    }
+
+    // Eight levels between the two endpoints, the first one is the largest
+    int palette[8] = {max, min};
+
+    for (int i = 2; i < 8; ++i)
+        palette[i] = ((8 - i) * max + (i - 1) * min) / 7;
+
+    uint64_t bits = 0;
+
+    for (int i = 0; i < 16; ++i)
+    {
+        int index = 0, best = 1 << 30;
+
+        for (int p = 0; p < 8; ++p)
+        {
+            const int diff = palette[p] - block[i][3];
+
+            if (diff * diff < best)
+            {
+                best = diff * diff;
+                index = p;
+            }
+        }
+
+        bits |= (uint64_t) index << (i * 3);
+    }
+
+    out[0] = max;
+    out[1] = min;
+
+    for (int i = 0; i < 6; ++i)
+        out[2 + i] = bits >> (i * 8);
+}
+
+uint16_t To565(const unsigned char *color)
+{
+    return ((color[0] * 31 + 127) / 255) << 11 | ((color[1] * 63 + 127) / 255) << 5 | (color[2] * 31 + 127) / 255;
+}
+
+void From565(uint16_t color, int out[3])
+{
+    const int r = color >> 11, g = (color >> 5) & 63, b = color & 31;
+
+    out[0] = r << 3 | r >> 2;
+    out[1] = g << 2 | g >> 4;
+    out[2] = b << 3 | b >> 2;
+}
+
+void EncodeDXT5Color(const unsigned char block[16][4], unsigned char *out)
+{
+    // The two texels furthest apart are the endpoints, ignoring the transparent ones when possible
+    int first = 0, second = 0, bestDistance = -1;
+    bool opaque = false;
+
+    for (int i = 0; i < 16; ++i)
+        opaque = opaque || block[i][3] > 0;
+
+    for (int i = 0; i < 16; ++i)
+    {
+        for (int j = i + 1; j < 16; ++j)
+        {
+            if (opaque && (block[i][3] == 0 || block[j][3] == 0))
+                continue;
+
+            int distance = 0;
+
+            for (int c = 0; c < 3; ++c)
+                distance += (block[i][c] - block[j][c]) * (block[i][c] - block[j][c]);
+
+            if (distance > bestDistance)
+            {
+                bestDistance = distance;
+                first = i;
+                second = j;
+            }
+        }
+    }
+
+    uint16_t color0 = To565(block[first]);
+    uint16_t color1 = To565(block[second]);
+
+    // DXT5 always decodes four colors, the larger endpoint first keeps DXT1 decoders in that mode too
+    if (color0 < color1)
+    {
+        const uint16_t swap = color0;
+        color0 = color1;
+        color1 = swap;
+    }
+
+    int palette[4][3];
+    From565(color0, palette[0]);
+    From565(color1, palette[1]);
+
+    for (int c = 0; c < 3; ++c)
+    {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+
+    uint32_t bits = 0;
+
+    for (int i = 0; color0 != color1 && i < 16; ++i)
+    {
+        int index = 0, best = 1 << 30;
+
+        for (int p = 0; p < 4; ++p)
+        {
+            int distance = 0;
+
+            for (int c = 0; c < 3; ++c)
+                distance += (palette[p][c] - block[i][c]) * (palette[p][c] - block[i][c]);
+
+            if (distance < best)
+            {
+                best = distance;
+                index = p;
+            }
+        }
+
+        bits |= (uint32_t) index << (i * 2);
+    }
+
+    out[0] = color0;
+    out[1] = color0 >> 8;
+    out[2] = color1;
+    out[3] = color1 >> 8;
+
+    for (int i = 0; i < 4; ++i)
+        out[4 + i] = bits >> (i * 8);
+}
+
+void EncodeS3TCBlock(const unsigned char block[16][4], unsigned char *out)
+{
+    EncodeDXT5Alpha(block, out);
+    EncodeDXT5Color(block, out + 8);
+}